@@ -20,39 +20,179 @@
 
 #pragma once
 
+#include "hist.h"
+#include "noise.h"
 #include "stats.h"
 #include "types.h"
 
+#include <time.h>
+
+/// Maximum number of implementations compared in a single benchmark.
+#define BENCH_MAX_IMPLS 16
+
+/// Routine implementation registered in a benchmark.
+typedef struct impl_s {
+    /// Name of the implementation.
+    char const* name;
+    /// Type-erased pointer to the implementation (cast back to the routine's `*_fn_t` type).
+    void (*fn)(void);
+    /// CPU features required to run the implementation (see `cpu_feature_t`).
+    uint32_t features;
+    /// Symbol of the implementation.
+    char const* symbol;
+} impl_t;
+
+/// Helper macro to register an implementation in a static table of `impl_t`.
+#define IMPL(name, fn, features) { name, (void (*)(void))(fn), features, #fn }
+
+/// Warmup state of an implementation.
+typedef struct warmup_s {
+    /// Start of the warmup.
+    struct timespec start;
+    /// Runtime of the previous warmup batch (in ns per call).
+    double prev;
+    /// Number of warmup batches run.
+    size_t nbatches;
+    /// Time spent warming up until steady state (in ns).
+    double elapsed;
+    /// Whether the runtime stabilized (`false` if the warmup stopped at `WARMUP_MAX_BATCHES`).
+    bool converged;
+} warmup_t;
+
+/// Order in which the samples of the compared implementations are collected.
+typedef enum sampling_e {
+    /// All samples of an implementation before moving to the next one (AAA...BBB...).
+    SAMPLING_BLOCKED,
+    /// One sample of each implementation per round, in registration order (ABAB...).
+    SAMPLING_ALTERNATE,
+    /// Same as `SAMPLING_ALTERNATE`, with the order reversed every other round (ABBA...).
+    SAMPLING_MIRRORED,
+    /// One sample of each implementation per round, in a random order.
+    SAMPLING_RANDOM,
+} sampling_t;
+
+/// Sample to collect: which implementation to run and where to store its measurement.
+typedef struct sample_slot_s {
+    /// Index of the implementation.
+    size_t impl;
+    /// Index of the sample.
+    size_t sample;
+} sample_slot_t;
+
+/// Memory traffic of a routine, to compare its bandwidth with the matching roofline.
+typedef enum traffic_e {
+    /// Reads the buffer (e.g. `strlen`).
+    TRAFFIC_READ,
+    /// Reads two buffers of the same size (e.g. `memcmp`).
+    TRAFFIC_READ2,
+    /// Reads the buffer and writes a copy of it (e.g. `memcpy`).
+    TRAFFIC_COPY,
+    /// Not comparable with a roofline (e.g. pipelines of routines).
+    TRAFFIC_NONE,
+} traffic_t;
+
 /// Benchmark information.
 typedef struct benchmark_s {
-    /// Name of the old implementation.
-    char name_old[32];
-    /// Name of the new implementation.
-    char name_new[32];
-    /// Runtime statistics for the old implementation.
-    statistics_t rt_old;
-    /// Runtime statistics for the new implementation.
-    statistics_t rt_new;
-    /// Bandwidth statistics of the old implementation.
-    statistics_t bw_old;
-    /// Bandwidth statistics of the new implementation.
-    statistics_t bw_new;
-    /// Runtime speedup of new over old.
-    double rt_speedup;
-    /// Bandwidth speedup of new over old.
-    double bw_speedup;
-    /// Buffer size used.
+    /// Name of the benchmark (e.g. `par_memcpy`), which tells apart implementations of the same
+    /// name registered by different benchmarks.
+    char const* routine;
+    /// Compared implementations (the first one is the reference for speedups).
+    impl_t const* impls;
+    /// Number of compared implementations.
+    size_t nimpls;
+    /// Runtime statistics of each implementation.
+    statistics_t rt[BENCH_MAX_IMPLS];
+    /// Bandwidth statistics of each implementation.
+    statistics_t bw[BENCH_MAX_IMPLS];
+    /// Runtime speedup of each implementation over the reference.
+    double rt_speedup[BENCH_MAX_IMPLS];
+    /// Bandwidth speedup of each implementation over the reference.
+    double bw_speedup[BENCH_MAX_IMPLS];
+    /// Warmup of each implementation.
+    warmup_t warmup[BENCH_MAX_IMPLS];
+    /// Paired runtime differences of each implementation with the reference (same round samples).
+    paired_t rt_diff[BENCH_MAX_IMPLS];
+    /// Buffer size used (in bytes).
     size_t buf_size;
+    /// Size of the elements of the buffer (in bytes, 0 is the same as 1), for element throughputs.
+    size_t elem_size;
+    /// Number of elements processed per call when they are not of a fixed size (e.g. records of a
+    /// pipeline benchmark), overrides `elem_size` if not 0.
+    size_t nelems;
+    /// Memory traffic of the routine (see `roofline.h`).
+    traffic_t traffic;
+    /// Excluded from the cost model (runtimes that are not of calls on the buffer, see `model.h`).
+    bool no_model;
+    /// Disturbed samples of each implementation (see `noise.h`).
+    noise_count_t noise[BENCH_MAX_IMPLS];
+    /// Number of sampling rounds left out of the statistics because one of their samples was
+    /// disturbed (`NOISE_REJECT` mode).
+    size_t nrejected;
     /// Number of samples.
     size_t nsamples;
     /// Number of repetitions per samples.
     size_t nreps;
 } benchmark_t;
 
-/// Processes the results of a benchmark.
-void bench_process(
-    benchmark_t self[static 1], size_t nsamples, double old[nsamples], double new[nsamples]
-);
+/// Selects the implementations of `registry` supported by the running CPU, in order.
+/// Returns the number of implementations written to `impls`.
+size_t bench_select(size_t n, impl_t const registry[n], impl_t impls[BENCH_MAX_IMPLS]);
+
+/// Enables instruction counting mode (see `scripts/icount.sh`): implementations are called once per
+/// buffer size, between `icount_begin` and `icount_end` markers, instead of being timed.
+void bench_set_counting(bool counting);
+
+/// Returns whether instruction counting mode is enabled.
+bool bench_counting(void);
+
+/// Enables latency mode: each call is timed individually with the generic timer and recorded in a
+/// histogram per implementation and buffer size, of which percentiles are printed instead of the
+/// usual table.
+void bench_set_latency(bool latency);
+
+/// Returns whether latency mode is enabled.
+bool bench_latency(void);
+
+/// Enables latency mode and appends the buckets of every histogram to the CSV file at `path`.
+/// Returns `false` if the file cannot be opened.
+bool bench_set_latency_dump(char const* path);
+
+/// Returns the latency histogram of `fn` in the running benchmark (histograms are cleared when the
+/// benchmark of a buffer size starts with `bench_schedule`).
+hist_t* bench_latency_hist(void (*fn)(void));
+
+/// Overhead of reading the timer (in ticks), subtracted from each recorded latency.
+uint64_t bench_latency_overhead(void);
+
+/// Marks the start of a counted call to `fn` (a new region for the instruction counting plugin).
+void icount_begin(void (*fn)(void));
+
+/// Marks the end of a counted call.
+void icount_end(void);
+
+/// Starts warming up an implementation.
+warmup_t bench_warmup_start(void);
+
+/// Records the runtime of a warmup batch (in ns per call).
+/// Returns `true` once two consecutive batches are within `WARMUP_TOLERANCE` of each other (or
+/// after `WARMUP_MAX_BATCHES` batches), at which point the warmup time and whether the runtime
+/// converged are recorded in `w`.
+bool bench_warmup_steady(warmup_t w[static 1], double batch);
+
+/// Sets the order in which samples are collected (defaults to `SAMPLING_RANDOM`).
+void bench_set_sampling(sampling_t sampling);
+
+/// Parses a sampling order name (`blocked`, `abab`, `abba` or `random`).
+/// Returns `false` if `name` is not a valid sampling order.
+bool bench_parse_sampling(char const* name, sampling_t sampling[static 1]);
+
+/// Fills `slots` with the order in which to collect `nsamples` samples of `nimpls` implementations.
+/// Sample `e` of every implementation is collected in the same round, so that samples sharing an
+/// index can be compared pairwise. Returns the number of slots written.
+size_t bench_schedule(size_t nimpls, size_t nsamples, sample_slot_t slots[nimpls * nsamples]);
+
+/// Processes the results of a benchmark (`samples` holds one row of samples per implementation).
+void bench_process(benchmark_t self[static 1], size_t nsamples, double samples[][nsamples]);
 
 /// Prints the results of a benchmark.
 void bench_print(benchmark_t const self[static 1]);
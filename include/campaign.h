@@ -0,0 +1,53 @@
+/**
+ * Copyright © 2004 - 2024, Université de Versailles Saint-Quentin-en-Yvelines (UVSQ)
+ * Copyright © 2024, Gabriel Dos Santos
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ **/
+
+#pragma once
+
+#include "types.h"
+
+/// Maximum number of cells (routine, build and vector length) of a campaign.
+#define CAMPAIGN_MAX_CELLS 4096
+
+/// Maximum number of values of each dimension of a campaign.
+#define CAMPAIGN_MAX_VALUES 64
+
+/// Name of the checkpoint file in the output directory of a campaign, listing its finished cells.
+#define CAMPAIGN_CHECKPOINT "campaign.done"
+
+/// Runs the campaign described by the file at `path`, and returns whether all its cells succeeded.
+///
+/// A campaign runs every routine of a matrix in its own process (an `exec` of a build of this
+/// benchmark), with one line of `<KEY>: <VALUES...>` per dimension (`#` starts a comment):
+/// - `routines`: long options of the routines to run (e.g. `memcmp strlen utf8-validate`),
+/// - `builds`: benchmark binaries (defaults to the running one), i.e. the size range, allocation
+///   alignment and baseline implementations chosen at build time (see `scripts/build.sh`),
+/// - `vl`: SVE vector lengths in bits set with `prctl` (defaults to the vector length of the CPU),
+/// - `options`: options passed to every run before the routine (e.g. `--noise reject`),
+/// - `cpus`: CPUs to run on (defaults to the affinity of the process), at most one job per
+///   physical core, on its first CPU (SMT siblings are left idle),
+/// - `bandwidth`: maximum number of jobs running at once per NUMA node, `exclusive` (1) or `shared`
+///   (one per core, the default), to keep jobs from competing for memory bandwidth,
+/// - `output`: directory of the results (defaults to `campaign`), with one
+///   `<routine>-<build>[-vl<VL>].dat` file per cell (`<build>` is the directory of the binary) and
+///   the standard error of its run in `.log`.
+///
+/// Finished cells are appended to `CAMPAIGN_CHECKPOINT` in the output directory, and skipped when
+/// the campaign is run again, so that an interrupted campaign resumes where it stopped.
+bool campaign_run(char const* path);
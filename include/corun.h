@@ -0,0 +1,64 @@
+/**
+ * Copyright © 2004 - 2024, Université de Versailles Saint-Quentin-en-Yvelines (UVSQ)
+ * Copyright © 2024, Gabriel Dos Santos
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ **/
+
+#pragma once
+
+#include "bench.h"
+#include "types.h"
+
+/// Maximum number of co-runner threads.
+#define CORUN_MAX_THREADS 64
+
+/// Period of the duty cycle of co-runners with an intensity below 100% (in ns).
+#define CORUN_PERIOD_NS 1000000ULL
+
+/// Kinds of co-runners, each on a buffer sized from the last level cache (LLC, from sysfs).
+typedef enum corun_kind_e {
+    /// Streaming bandwidth hog: copies through a buffer of four times the LLC (at least 64 MiB).
+    CORUN_BW,
+    /// Latency hog: chases pointers through a random cycle of cache lines of the same buffer.
+    CORUN_CHASE,
+    /// LLC thrasher: reads and writes a cache line at a time through a buffer the size of the LLC.
+    CORUN_LLC,
+} corun_kind_t;
+
+/// Adds co-runner threads from `spec`: `<KIND>[@<INTENSITY>]:<CPU>[,<CPU>...]`, where `KIND` is
+/// `bw`, `chase` or `llc`, `INTENSITY` the percentage of time the threads run (100 by default),
+/// and each `CPU` a CPU number or `sibling`, an SMT sibling of the CPU of the benchmark thread
+/// (which is pinned to its current CPU when the first co-runner is added).
+/// The threads are started paused. Returns `false` if `spec` is invalid.
+bool corun_add(char const* spec);
+
+/// Returns whether co-runners were added.
+bool corun_enabled(void);
+
+/// Resumes (`true`) or pauses (`false`) the co-runners. Benchmarks processed while they run are
+/// recorded as loaded runs, the others as isolated runs.
+void corun_set_loaded(bool loaded);
+
+/// Returns whether the co-runners are running.
+bool corun_loaded(void);
+
+/// Records the average runtimes of a processed benchmark, as an isolated or a loaded run.
+void corun_record(benchmark_t const bench[static 1]);
+
+/// Prints the work done by each co-runner, and the slowdown of each implementation and buffer size
+/// recorded both isolated and loaded.
+void corun_report(void);
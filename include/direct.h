@@ -0,0 +1,108 @@
+/**
+ * Copyright © 2004 - 2024, Université de Versailles Saint-Quentin-en-Yvelines (UVSQ)
+ * Copyright © 2024, Gabriel Dos Santos
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ **/
+
+#pragma once
+
+#include "bench.h"
+#include "types.h"
+
+/// Maximum number of results (implementation and buffer size) of the call overhead report.
+#define DIRECT_MAX_RESULTS 4096
+
+/// Unroll factors of the direct-call drivers (calls per loop iteration).
+#define DIRECT_UNROLLS { 1, 4, 8 }
+
+/// Number of unroll factors of the direct-call drivers.
+#define DIRECT_NUNROLLS 3
+
+/// Type-erased direct-call driver (cast back to the `direct_*_fn_t` type of its routine).
+typedef void (*direct_driver_t)(void);
+
+// Direct-call drivers take the arguments of the `driver_*` function of their routine, without the
+// pointer to the implementation, which they call by symbol (see `registry.h`).
+typedef void direct_memcmp_fn_t(
+    size_t nsamples, size_t nreps, double samples[nsamples], void const* s1, void const* s2,
+    size_t n
+);
+typedef void direct_memcpy_fn_t(
+    size_t nsamples, size_t nreps, double samples[nsamples], void* restrict dst,
+    void const* restrict src, size_t n
+);
+typedef void direct_strcmp_fn_t(
+    size_t nsamples, size_t nreps, double samples[nsamples], char const* s1, char const* s2
+);
+typedef void direct_strncmp_fn_t(
+    size_t nsamples, size_t nreps, double samples[nsamples], char const* s1, char const* s2,
+    size_t n
+);
+typedef void direct_strchr_fn_t(
+    size_t nsamples, size_t nreps, double samples[nsamples], char const* s, int32_t c
+);
+typedef void direct_strrchr_fn_t(
+    size_t nsamples, size_t nreps, double samples[nsamples], char const* s, int32_t c
+);
+typedef void direct_strcpy_fn_t(
+    size_t nsamples, size_t nreps, double samples[nsamples], char* restrict dst,
+    char const* restrict src
+);
+typedef void direct_strncpy_fn_t(
+    size_t nsamples, size_t nreps, double samples[nsamples], char* restrict dst,
+    char const* restrict src, size_t n
+);
+typedef void direct_strlen_fn_t(
+    size_t nsamples, size_t nreps, double samples[nsamples], char const* s
+);
+typedef void direct_strnlen_fn_t(
+    size_t nsamples, size_t nreps, double samples[nsamples], char const* s, size_t n
+);
+
+/// Parses an unroll factor of the direct-call drivers (`1`, `4` or `8`).
+/// Returns `false` if `arg` is not a valid unroll factor.
+bool direct_parse_unroll(char const* arg, size_t unroll[static 1]);
+
+/// Times the implementations of the routines of `registry.h` with their direct-call drivers,
+/// unrolled `unroll` times (0, the default, uses the `driver_*` functions).
+void direct_set_unroll(size_t unroll);
+
+/// Returns the direct-call driver of `fn` at the selected unroll factor, or `NULL` if direct calls
+/// are disabled, not supported by the mode (instruction counting or latency), or `fn` has none.
+direct_driver_t direct_driver(void (*fn)(void));
+
+/// Enables the call overhead report: benchmarks of the routines of `registry.h` run through the
+/// `driver_*` functions, then again through the direct-call drivers at each unroll factor.
+void direct_set_report(bool report);
+
+/// Returns whether the call overhead report is enabled (and supported by the mode).
+bool direct_reporting(void);
+
+/// Starts (`unroll` > 0) or ends (0) a rerun of benchmarks through the direct-call drivers for the
+/// call overhead report. Reruns are not recorded for the dispatch table, the cost model or the
+/// interference report.
+void direct_set_rerun(size_t unroll);
+
+/// Returns whether a rerun for the call overhead report is in progress.
+bool direct_rerun(void);
+
+/// Records the average runtimes of a processed benchmark for the call overhead report.
+void direct_record(benchmark_t const bench[static 1]);
+
+/// Prints the runtime of each implementation and buffer size through the `driver_*` functions and
+/// the direct-call drivers, and the overhead of the former.
+void direct_report(void);
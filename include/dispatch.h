@@ -0,0 +1,78 @@
+/**
+ * Copyright © 2004 - 2024, Université de Versailles Saint-Quentin-en-Yvelines (UVSQ)
+ * Copyright © 2024, Gabriel Dos Santos
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ **/
+
+#pragma once
+
+#include "bench.h"
+#include "types.h"
+#include "utils.h"
+
+// Dispatch table selected at build time (`DISPATCH_TABLE` CMake variable). For each routine, it
+// defines `DISPATCH_<ROUTINE>(X)`, expanding `X(max_size, symbol)` for each size class in increasing
+// order (the last one up to `SIZE_MAX`), and `DISPATCH_<ROUTINE>_FEATURES`, the CPU features
+// required by the implementations it uses. Routines missing from the table use LI-PaRAD.
+#include "dispatch_table.h"
+
+#ifndef DISPATCH_MEMCPY
+    #define DISPATCH_MEMCPY(X) X(SIZE_MAX, new_memcpy_aarch64_sve)
+    #define DISPATCH_MEMCPY_FEATURES CPU_FEAT_SVE
+#endif
+#ifndef DISPATCH_MEMCMP
+    #define DISPATCH_MEMCMP(X) X(SIZE_MAX, new_memcmp_aarch64_sve)
+    #define DISPATCH_MEMCMP_FEATURES CPU_FEAT_SVE
+#endif
+#ifndef DISPATCH_STRNCMP
+    #define DISPATCH_STRNCMP(X) X(SIZE_MAX, new_strncmp_aarch64_sve)
+    #define DISPATCH_STRNCMP_FEATURES CPU_FEAT_SVE
+#endif
+#ifndef DISPATCH_STRNLEN
+    #define DISPATCH_STRNLEN(X) X(SIZE_MAX, new_strnlen_aarch64_sve)
+    #define DISPATCH_STRNLEN_FEATURES CPU_FEAT_SVE
+#endif
+#ifndef DISPATCH_STRNCPY
+    #define DISPATCH_STRNCPY(X) X(SIZE_MAX, new_strncpy_aarch64_sve)
+    #define DISPATCH_STRNCPY_FEATURES CPU_FEAT_SVE
+#endif
+
+/// Maximum number of size classes in the dispatch table of a routine.
+#define DISPATCH_MAX_ENTRIES 64
+
+/// Enables writing the dispatch table measured by the benchmarks to `path`, as a C header
+/// (see `include/dispatch/`). The table is written by `dispatch_write`.
+void dispatch_set_output(char const* path);
+
+/// Records the results of a benchmark of `routine` on a buffer size: the fastest implementation
+/// for the dispatch table (the composite itself excluded) and the runtime of each implementation.
+void dispatch_record(char const* routine, benchmark_t const bench[static 1]);
+
+/// Prints whether the composite implementation of `routine` beats every single implementation
+/// over the recorded sweep (sum of average runtimes over all buffer sizes).
+void dispatch_check(char const* routine);
+
+/// Writes the dispatch tables of all recorded routines, if enabled.
+void dispatch_write(void);
+
+// Composite implementations, dispatching to an implementation per size class according to the
+// table selected at build time (`DISPATCH_TABLE` CMake variable)
+void* dispatch_memcpy(void* restrict dst, void const* restrict src, size_t n);
+int32_t dispatch_memcmp(void const* s1, void const* s2, size_t n);
+int32_t dispatch_strncmp(char const* s1, char const* s2, size_t n);
+size_t dispatch_strnlen(char const* s, size_t n);
+char* dispatch_strncpy(char* restrict dst, char const* restrict src, size_t n);
@@ -0,0 +1,4 @@
+// Default dispatch table: every size class uses the LI-PaRAD implementation.
+// Generate a table for the current CPU with `bench-sve-string-routines --dispatch <FILE> ...`.
+
+#pragma once
@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include "pipeline.h"
 #include "types.h"
 
 // Declarations for current string optimized-routines
@@ -36,26 +37,148 @@ extern size_t __strnlen_aarch64_sve(char const* s, size_t n);
 // Declarations for the new implementations of string optimized-routines
 extern int32_t new_memcmp_aarch64_sve(void const* s1, void const* s2, size_t n);
 extern void* new_memcpy_aarch64_sve(void* restrict dst, void const* restrict src, size_t n);
+extern void* new_memcpy_x2_aarch64_sve(void* restrict dst, void const* restrict src, size_t n);
+extern void* new_memcpy_x4_aarch64_sve(void* restrict dst, void const* restrict src, size_t n);
+extern void* new_memcpy_auto_aarch64_sve(void* restrict dst, void const* restrict src, size_t n);
 extern int32_t new_strcmp_aarch64_sve(char const* s1, char const* s2);
 extern int32_t new_strncmp_aarch64_sve(char const* dst, char const* src, size_t n);
+extern int32_t new_strcasecmp_aarch64_sve(char const* s1, char const* s2);
+extern int32_t new_strncasecmp_aarch64_sve(char const* s1, char const* s2, size_t n);
 extern char* new_strchr_aarch64_sve(char const* s, int32_t c);
 extern char* new_strrchr_aarch64_sve(char const* s, int32_t c);
+extern char* new_strchr_aarch64_sve2(char const* s, int32_t c);
+extern char* new_strrchr_aarch64_sve2(char const* s, int32_t c);
 extern char* new_strcpy_aarch64_sve(char* restrict dst, char const* restrict src);
 extern char* new_strncpy_aarch64_sve(char* restrict dst, char const* restrict src, size_t n);
 extern size_t new_strlen_aarch64_sve(char const* s);
+extern size_t new_strlen_x2_aarch64_sve(char const* s);
+extern size_t new_strlen_x4_aarch64_sve(char const* s);
+extern size_t new_strlen_auto_aarch64_sve(char const* s);
 extern size_t new_strnlen_aarch64_sve(char const* s, size_t n);
+extern void new_strlen_batch_aarch64_sve(char const* const* ptrs, size_t n, size_t* out);
+extern void new_strcmp_batch_aarch64_sve(
+    char const* const* s1, char const* const* s2, size_t n, int32_t* out
+);
+
+// Declarations for the new implementations of wide-character routines (`.s` elements)
+extern size_t new_wcslen_aarch64_sve(wchar_t const* s);
+extern size_t new_wcsnlen_aarch64_sve(wchar_t const* s, size_t n);
+extern int32_t new_wcscmp_aarch64_sve(wchar_t const* s1, wchar_t const* s2);
+extern int32_t new_wcsncmp_aarch64_sve(wchar_t const* s1, wchar_t const* s2, size_t n);
+extern wchar_t* new_wcschr_aarch64_sve(wchar_t const* s, wchar_t c);
+extern wchar_t* new_wmemchr_aarch64_sve(wchar_t const* s, wchar_t c, size_t n);
+extern wchar_t* new_wcscpy_aarch64_sve(wchar_t* restrict dst, wchar_t const* restrict src);
+extern wchar_t* new_wcsncpy_aarch64_sve(
+    wchar_t* restrict dst, wchar_t const* restrict src, size_t n
+);
+
+// Declarations for the new UTF-8 kernels
+extern int32_t new_utf8_validate_aarch64_sve(char const* s, size_t n);
+extern size_t new_utf8_count_codepoints_aarch64_sve(char const* s, size_t n);
+
+// Declarations for the AdvSIMD implementations of string routines
+extern int32_t advsimd_memcmp_aarch64(void const* s1, void const* s2, size_t n);
+extern void* advsimd_memcpy_aarch64(void* restrict dst, void const* restrict src, size_t n);
+extern int32_t advsimd_strcmp_aarch64(char const* s1, char const* s2);
+extern int32_t advsimd_strncmp_aarch64(char const* s1, char const* s2, size_t n);
+extern int32_t advsimd_strcasecmp_aarch64(char const* s1, char const* s2);
+extern int32_t advsimd_strncasecmp_aarch64(char const* s1, char const* s2, size_t n);
+extern char* advsimd_strchr_aarch64(char const* s, int32_t c);
+extern char* advsimd_strrchr_aarch64(char const* s, int32_t c);
+extern char* advsimd_strcpy_aarch64(char* restrict dst, char const* restrict src);
+extern char* advsimd_strncpy_aarch64(char* restrict dst, char const* restrict src, size_t n);
+extern size_t advsimd_strlen_aarch64(char const* s);
+extern size_t advsimd_strnlen_aarch64(char const* s, size_t n);
+extern int32_t advsimd_utf8_validate_aarch64(char const* s, size_t n);
+extern size_t advsimd_utf8_count_codepoints_aarch64(char const* s, size_t n);
+
+// Fixed vector length builds of the new string routines (128-bit and 256-bit vectors)
+extern int32_t new_memcmp_aarch64_sve_vl128(void const* s1, void const* s2, size_t n);
+extern int32_t new_memcmp_aarch64_sve_vl256(void const* s1, void const* s2, size_t n);
+extern int32_t new_strcmp_aarch64_sve_vl128(char const* s1, char const* s2);
+extern int32_t new_strcmp_aarch64_sve_vl256(char const* s1, char const* s2);
+extern int32_t new_strncmp_aarch64_sve_vl128(char const* s1, char const* s2, size_t n);
+extern int32_t new_strncmp_aarch64_sve_vl256(char const* s1, char const* s2, size_t n);
+extern size_t new_strlen_aarch64_sve_vl128(char const* s);
+extern size_t new_strlen_aarch64_sve_vl256(char const* s);
+extern size_t new_strnlen_aarch64_sve_vl128(char const* s, size_t n);
+extern size_t new_strnlen_aarch64_sve_vl256(char const* s, size_t n);
+
+// Declarations for the ACLE intrinsics implementations of string routines, built by GCC and Clang.
+// They are weak: those built by a compiler that is not configured are null and skipped.
+#define ACLE_DECLARE(cc)                                                                          \
+    extern int32_t acle_##cc##_memcmp_aarch64_sve(void const* s1, void const* s2, size_t n)        \
+        __attribute__((weak));                                                                    \
+    extern void* acle_##cc##_memcpy_aarch64_sve(void* restrict dst, void const* restrict src,      \
+                                                size_t n) __attribute__((weak));                  \
+    extern int32_t acle_##cc##_strcmp_aarch64_sve(char const* s1, char const* s2)                 \
+        __attribute__((weak));                                                                    \
+    extern int32_t acle_##cc##_strncmp_aarch64_sve(char const* s1, char const* s2, size_t n)      \
+        __attribute__((weak));                                                                    \
+    extern int32_t acle_##cc##_strcasecmp_aarch64_sve(char const* s1, char const* s2)             \
+        __attribute__((weak));                                                                    \
+    extern int32_t acle_##cc##_strncasecmp_aarch64_sve(char const* s1, char const* s2, size_t n)  \
+        __attribute__((weak));                                                                    \
+    extern char* acle_##cc##_strchr_aarch64_sve(char const* s, int32_t c) __attribute__((weak));  \
+    extern char* acle_##cc##_strrchr_aarch64_sve(char const* s, int32_t c) __attribute__((weak)); \
+    extern char* acle_##cc##_strcpy_aarch64_sve(char* restrict dst, char const* restrict src)     \
+        __attribute__((weak));                                                                    \
+    extern char* acle_##cc##_strncpy_aarch64_sve(char* restrict dst, char const* restrict src,    \
+                                                 size_t n) __attribute__((weak));                 \
+    extern size_t acle_##cc##_strlen_aarch64_sve(char const* s) __attribute__((weak));            \
+    extern size_t acle_##cc##_strnlen_aarch64_sve(char const* s, size_t n) __attribute__((weak));
+ACLE_DECLARE(gcc)
+ACLE_DECLARE(clang)
+
+// Declarations for the plain C reference implementations of string routines
+extern int32_t ref_memcmp(void const* s1, void const* s2, size_t n);
+extern void* ref_memcpy(void* restrict dst, void const* restrict src, size_t n);
+extern int32_t ref_strcmp(char const* s1, char const* s2);
+extern int32_t ref_strncmp(char const* s1, char const* s2, size_t n);
+extern int32_t ref_strcasecmp(char const* s1, char const* s2);
+extern int32_t ref_strncasecmp(char const* s1, char const* s2, size_t n);
+extern char* ref_strchr(char const* s, int32_t c);
+extern char* ref_strrchr(char const* s, int32_t c);
+extern char* ref_strcpy(char* restrict dst, char const* restrict src);
+extern char* ref_strncpy(char* restrict dst, char const* restrict src, size_t n);
+extern size_t ref_strlen(char const* s);
+extern size_t ref_strnlen(char const* s, size_t n);
+extern size_t ref_wcslen(wchar_t const* s);
+extern size_t ref_wcsnlen(wchar_t const* s, size_t n);
+extern int32_t ref_wcscmp(wchar_t const* s1, wchar_t const* s2);
+extern int32_t ref_wcsncmp(wchar_t const* s1, wchar_t const* s2, size_t n);
+extern wchar_t* ref_wcschr(wchar_t const* s, wchar_t c);
+extern wchar_t* ref_wmemchr(wchar_t const* s, wchar_t c, size_t n);
+extern wchar_t* ref_wcscpy(wchar_t* restrict dst, wchar_t const* restrict src);
+extern wchar_t* ref_wcsncpy(wchar_t* restrict dst, wchar_t const* restrict src, size_t n);
+extern int32_t ref_utf8_validate(char const* s, size_t n);
+extern size_t ref_utf8_count_codepoints(char const* s, size_t n);
 
 // Function pointer type declarations
 typedef int32_t memcmp_fn_t(void const*, void const*, size_t);
 typedef void* memcpy_fn_t(void* restrict, void const* restrict, size_t);
 typedef int32_t strcmp_fn_t(char const*, char const*);
 typedef int32_t strncmp_fn_t(char const*, char const*, size_t);
+typedef int32_t strcasecmp_fn_t(char const*, char const*);
+typedef int32_t strncasecmp_fn_t(char const*, char const*, size_t);
 typedef char* strchr_fn_t(char const*, int32_t);
 typedef char* strrchr_fn_t(char const*, int32_t);
 typedef char* strcpy_fn_t(char* restrict, char const* restrict);
 typedef char* strncpy_fn_t(char* restrict, char const* restrict, size_t);
 typedef size_t strlen_fn_t(char const*);
 typedef size_t strnlen_fn_t(char const*, size_t);
+typedef void strlen_batch_fn_t(char const* const*, size_t, size_t*);
+typedef void strcmp_batch_fn_t(char const* const*, char const* const*, size_t, int32_t*);
+typedef size_t wcslen_fn_t(wchar_t const*);
+typedef size_t wcsnlen_fn_t(wchar_t const*, size_t);
+typedef int32_t wcscmp_fn_t(wchar_t const*, wchar_t const*);
+typedef int32_t wcsncmp_fn_t(wchar_t const*, wchar_t const*, size_t);
+typedef wchar_t* wcschr_fn_t(wchar_t const*, wchar_t);
+typedef wchar_t* wmemchr_fn_t(wchar_t const*, wchar_t, size_t);
+typedef wchar_t* wcscpy_fn_t(wchar_t* restrict, wchar_t const* restrict);
+typedef wchar_t* wcsncpy_fn_t(wchar_t* restrict, wchar_t const* restrict, size_t);
+typedef int32_t utf8_validate_fn_t(char const*, size_t);
+typedef size_t utf8_count_codepoints_fn_t(char const*, size_t);
 
 void driver_memcmp(
     size_t nsamples,
@@ -77,6 +200,21 @@ void driver_memcpy(
     size_t n
 );
 
+/// Benchmarks the cache pollution of a copy: before each sample, the `victim` working set is read
+/// to bring it in cache, then `n` bytes are copied and `victim` is read again. `copy` holds the
+/// runtime of the copy and `reread` the runtime of the second read (in ns).
+void driver_memcpy_pollution(
+    size_t nsamples,
+    double copy[nsamples],
+    double reread[nsamples],
+    memcpy_fn_t* memcpy_fn,
+    void* restrict dst,
+    void const* restrict src,
+    size_t n,
+    uint64_t const* victim,
+    size_t victim_size
+);
+
 void driver_strcmp(
     size_t nsamples,
     size_t nreps,
@@ -96,6 +234,25 @@ void driver_strncmp(
     size_t n
 );
 
+void driver_strcasecmp(
+    size_t nsamples,
+    size_t nreps,
+    double samples[nsamples],
+    strcasecmp_fn_t* strcasecmp_fn,
+    char const* s1,
+    char const* s2
+);
+
+void driver_strncasecmp(
+    size_t nsamples,
+    size_t nreps,
+    double samples[nsamples],
+    strncasecmp_fn_t* strncasecmp_fn,
+    char const* s1,
+    char const* s2,
+    size_t n
+);
+
 void driver_strchr(
     size_t nsamples,
     size_t nreps,
@@ -149,3 +306,124 @@ void driver_strnlen(
     char const* s,
     size_t n
 );
+
+void driver_strlen_batch(
+    size_t nsamples,
+    size_t nreps,
+    double samples[nsamples],
+    strlen_batch_fn_t* strlen_batch_fn,
+    char const* const* ptrs,
+    size_t n,
+    size_t* out
+);
+
+void driver_strcmp_batch(
+    size_t nsamples,
+    size_t nreps,
+    double samples[nsamples],
+    strcmp_batch_fn_t* strcmp_batch_fn,
+    char const* const* s1,
+    char const* const* s2,
+    size_t n,
+    int32_t* out
+);
+
+void driver_wcslen(
+    size_t nsamples,
+    size_t nreps,
+    double samples[nsamples],
+    wcslen_fn_t* wcslen_fn,
+    wchar_t const* s
+);
+
+void driver_wcsnlen(
+    size_t nsamples,
+    size_t nreps,
+    double samples[nsamples],
+    wcsnlen_fn_t* wcsnlen_fn,
+    wchar_t const* s,
+    size_t n
+);
+
+void driver_wcscmp(
+    size_t nsamples,
+    size_t nreps,
+    double samples[nsamples],
+    wcscmp_fn_t* wcscmp_fn,
+    wchar_t const* s1,
+    wchar_t const* s2
+);
+
+void driver_wcsncmp(
+    size_t nsamples,
+    size_t nreps,
+    double samples[nsamples],
+    wcsncmp_fn_t* wcsncmp_fn,
+    wchar_t const* s1,
+    wchar_t const* s2,
+    size_t n
+);
+
+void driver_wcschr(
+    size_t nsamples,
+    size_t nreps,
+    double samples[nsamples],
+    wcschr_fn_t* wcschr_fn,
+    wchar_t const* s,
+    wchar_t c
+);
+
+void driver_wmemchr(
+    size_t nsamples,
+    size_t nreps,
+    double samples[nsamples],
+    wmemchr_fn_t* wmemchr_fn,
+    wchar_t const* s,
+    wchar_t c,
+    size_t n
+);
+
+void driver_wcscpy(
+    size_t nsamples,
+    size_t nreps,
+    double samples[nsamples],
+    wcscpy_fn_t* wcscpy_fn,
+    wchar_t* dst,
+    wchar_t const* src
+);
+
+void driver_wcsncpy(
+    size_t nsamples,
+    size_t nreps,
+    double samples[nsamples],
+    wcsncpy_fn_t* wcsncpy_fn,
+    wchar_t* dst,
+    wchar_t const* src,
+    size_t n
+);
+
+void driver_utf8_validate(
+    size_t nsamples,
+    size_t nreps,
+    double samples[nsamples],
+    utf8_validate_fn_t* utf8_validate_fn,
+    char const* s,
+    size_t n
+);
+
+void driver_utf8_count_codepoints(
+    size_t nsamples,
+    size_t nreps,
+    double samples[nsamples],
+    utf8_count_codepoints_fn_t* utf8_count_codepoints_fn,
+    char const* s,
+    size_t n
+);
+
+void driver_pipeline(
+    size_t nsamples,
+    size_t nreps,
+    double samples[nsamples],
+    pipeline_fn_t* pipeline_fn,
+    pipeline_corpus_t const* corpus
+);
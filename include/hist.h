@@ -0,0 +1,95 @@
+/**
+ * Copyright © 2004 - 2024, Université de Versailles Saint-Quentin-en-Yvelines (UVSQ)
+ * Copyright © 2024, Gabriel Dos Santos
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ **/
+
+#pragma once
+
+#include "types.h"
+
+/// Log-linear (HDR-style) histogram of per-call latencies, in ticks of the generic timer.
+///
+/// Values below `2^HIST_SUB_BITS` have a bucket each; above, every power of two is split in
+/// `2^(HIST_SUB_BITS - 1)` buckets, which bounds the relative error of a recorded value to
+/// `2^-(HIST_SUB_BITS - 1)` (below 1.6%). Values are clamped to `2^HIST_MAX_BITS - 1`.
+#define HIST_SUB_BITS 7
+#define HIST_MAX_BITS 40
+#define HIST_HALF (1ULL << (HIST_SUB_BITS - 1))
+#define HIST_NBUCKETS ((HIST_MAX_BITS - HIST_SUB_BITS + 2) * HIST_HALF)
+
+typedef struct hist_s {
+    /// Number of values recorded in each bucket.
+    uint64_t counts[HIST_NBUCKETS];
+    /// Number of values recorded.
+    uint64_t total;
+    /// Largest value recorded (exact).
+    uint64_t max;
+} hist_t;
+
+/// Reads the virtual count of the generic timer (ordered after the preceding instructions).
+static inline uint64_t hist_ticks(void) {
+    uint64_t t;
+    __asm__ volatile("isb\n\tmrs %0, cntvct_el0" : "=r"(t) : : "memory");
+    return t;
+}
+
+/// Frequency of the generic timer (in Hz).
+static inline uint64_t hist_freq(void) {
+    uint64_t f;
+    __asm__ volatile("mrs %0, cntfrq_el0" : "=r"(f));
+    return f;
+}
+
+/// Index of the bucket of a value.
+static inline size_t hist_bucket(uint64_t v) {
+    if (v < 2 * HIST_HALF) {
+        return (size_t)v;
+    }
+    if (v >> HIST_MAX_BITS) {
+        v = (1ULL << HIST_MAX_BITS) - 1;
+    }
+    size_t const shift = (size_t)(63 - __builtin_clzll(v)) - (HIST_SUB_BITS - 1);
+    return (size_t)(shift * HIST_HALF + (v >> shift));
+}
+
+/// Records a value (no allocation, constant time).
+static inline void hist_record(hist_t h[static 1], uint64_t v) {
+    h->counts[hist_bucket(v)] += 1;
+    h->total += 1;
+    h->max = v > h->max ? v : h->max;
+}
+
+/// Clears all recorded values.
+void hist_reset(hist_t h[static 1]);
+
+/// Smallest value of bucket `b`.
+uint64_t hist_bucket_low(size_t b);
+
+/// Largest value of bucket `b`.
+uint64_t hist_bucket_high(size_t b);
+
+/// Value below which `p` percent of the recorded values are (the largest value of their bucket,
+/// or the exact maximum for the last one).
+uint64_t hist_percentile(hist_t const h[static 1], double p);
+
+/// Smallest difference between two consecutive reads of the timer (in ticks), to subtract from
+/// the recorded values.
+uint64_t hist_timer_overhead(void);
+
+/// Converts ticks of the generic timer to nanoseconds.
+double hist_ticks_to_ns(uint64_t ticks);
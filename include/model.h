@@ -0,0 +1,44 @@
+/**
+ * Copyright © 2004 - 2024, Université de Versailles Saint-Quentin-en-Yvelines (UVSQ)
+ * Copyright © 2024, Gabriel Dos Santos
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ **/
+
+#pragma once
+
+#include "bench.h"
+#include "types.h"
+
+/// Maximum number of implementations (series of measurements) recorded for the cost model.
+#define MODEL_MAX_SERIES 128
+
+/// Maximum number of buffer sizes recorded per implementation.
+#define MODEL_MAX_POINTS 128
+
+/// Enables recording the average runtime of each benchmarked implementation per buffer size, to
+/// fit a piecewise-linear cost model (`time = a + b * n` per cache regime) with `model_report`.
+void model_set_enabled(bool enabled);
+
+/// Records the average runtimes of a processed benchmark, if enabled (benchmarks marked with
+/// `no_model` and instruction counting runs are ignored). Implementations are identified by name.
+void model_record(benchmark_t const bench[static 1]);
+
+/// Fits and prints the cost model of every recorded implementation: for each cache regime (buffer
+/// sizes up to the L1, L2 and L3 data cache sizes from sysfs, then beyond), the startup cost `a` in
+/// ns, the asymptotic throughput `1 / b` in bytes per ns and per cycle, and the coefficient of
+/// determination, compared with the reference implementation of the benchmark.
+void model_report(void);
@@ -0,0 +1,101 @@
+/**
+ * Copyright © 2004 - 2024, Université de Versailles Saint-Quentin-en-Yvelines (UVSQ)
+ * Copyright © 2024, Gabriel Dos Santos
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ **/
+
+#pragma once
+
+#include "types.h"
+
+/// Maximum number of samples per implementation whose disturbances are recorded.
+#define NOISE_MAX_SAMPLES 1024
+
+/// Handling of the samples disturbed by the system.
+typedef enum noise_mode_e {
+    /// Disturbances are not captured.
+    NOISE_OFF,
+    /// Disturbed samples are counted and reported, but kept in the statistics.
+    NOISE_FLAG,
+    /// Disturbed samples are counted, reported, and left out of the statistics.
+    NOISE_REJECT,
+} noise_mode_t;
+
+/// Disturbances of a sample.
+typedef enum noise_flag_e {
+    /// The thread was preempted (involuntary context switch).
+    NOISE_PREEMPTED = 1 << 0,
+    /// The thread was migrated to another CPU.
+    NOISE_MIGRATED = 1 << 1,
+    /// The thread took a page fault (minor or major).
+    NOISE_FAULTED = 1 << 2,
+} noise_flag_t;
+
+/// State of the running thread, taken before and after each sample.
+typedef struct noise_s {
+    /// CPU the thread runs on.
+    int32_t cpu;
+    /// Number of involuntary context switches.
+    long nivcsw;
+    /// Number of minor and major page faults.
+    long nflt;
+} noise_t;
+
+/// Parses a noise mode name (`off`, `flag` or `reject`).
+/// Returns `false` if `name` is not a valid noise mode.
+bool noise_parse_mode(char const* name, noise_mode_t mode[static 1]);
+
+/// Sets the handling of disturbed samples (defaults to `NOISE_OFF`), and prints the environment of
+/// the run (see `noise_environment`) when they are captured.
+void noise_set_mode(noise_mode_t mode);
+
+/// Returns the handling of disturbed samples.
+noise_mode_t noise_mode(void);
+
+/// Prints the settings of the system that disturb benchmarks (CPU frequency governor, isolated
+/// CPUs, transparent huge pages and load average) as `# key: value` metadata lines, and warns on
+/// `stderr` about those that are likely to add noise.
+void noise_environment(void);
+
+/// Takes a snapshot of the state of the running thread.
+noise_t noise_snapshot(void);
+
+/// Returns the disturbances (`noise_flag_t`) between two snapshots of the running thread.
+uint32_t noise_compare(noise_t const before[static 1], noise_t const after[static 1]);
+
+/// Counts of the disturbed samples of an implementation.
+typedef struct noise_count_s {
+    /// Samples with any disturbance.
+    size_t disturbed;
+    /// Samples during which the thread was preempted.
+    size_t preempted;
+    /// Samples during which the thread was migrated.
+    size_t migrated;
+    /// Samples during which the thread took page faults.
+    size_t faulted;
+} noise_count_t;
+
+/// Records the disturbances of the next sample of `fn` (samples of an implementation are collected
+/// in order, see `bench_schedule`).
+void noise_record(void (*fn)(void), uint32_t flags);
+
+/// Returns the disturbances of each sample of `fn` recorded since the last `noise_reset` (0 for the
+/// samples that were not recorded), or `NULL` if none was.
+uint8_t const* noise_flags(void (*fn)(void));
+
+/// Clears the recorded disturbances of all implementations.
+void noise_reset(void);
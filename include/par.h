@@ -0,0 +1,64 @@
+/**
+ * Copyright © 2004 - 2024, Université de Versailles Saint-Quentin-en-Yvelines (UVSQ)
+ * Copyright © 2024, Gabriel Dos Santos
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ **/
+
+#pragma once
+
+#include "types.h"
+
+/// Maximum number of threads of the pool (including the calling thread).
+#define PAR_MAX_THREADS 64
+
+/// Minimum number of bytes per thread below which `par_memcpy` and `par_memcmp` use fewer threads
+/// (a single one runs the kernel directly).
+#ifndef PAR_MIN_CHUNK
+    #define PAR_MIN_CHUNK (8ULL << 20)
+#endif
+
+/// Saves the affinity mask of the process, from which the pool is built. Must be called at startup,
+/// before any thread is pinned to a CPU.
+void par_save_affinity(void);
+
+/// Number of threads of the pool: one per CPU the process may run on, up to `PAR_MAX_THREADS`.
+/// The pool is started on first use, each worker pinned to its own CPU but the first one.
+size_t par_pool_size(void);
+
+/// Pins the calling thread to the first CPU of the pool, which no worker runs on, until
+/// `par_unbind` restores its previous affinity.
+void par_bind(void);
+
+/// Restores the affinity of the calling thread saved by `par_bind`.
+void par_unbind(void);
+
+/// Number of threads used by `par_memcpy` and `par_memcmp` for `n` bytes.
+size_t par_nthreads(size_t n);
+
+/// Copies `n` bytes with the new SVE kernel, split in page-aligned chunks over `nthreads` threads
+/// of the pool (the calling thread included).
+void* par_memcpy_n(size_t nthreads, void* restrict dst, void const* restrict src, size_t n);
+
+/// Compares `n` bytes with the new SVE kernel, split in page-aligned chunks over `nthreads`
+/// threads of the pool (the calling thread included).
+int32_t par_memcmp_n(size_t nthreads, void const* s1, void const* s2, size_t n);
+
+/// Same as `par_memcpy_n`, with the number of threads chosen by size (see `par_nthreads`).
+void* par_memcpy(void* restrict dst, void const* restrict src, size_t n);
+
+/// Same as `par_memcmp_n`, with the number of threads chosen by size (see `par_nthreads`).
+int32_t par_memcmp(void const* s1, void const* s2, size_t n);
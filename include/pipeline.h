@@ -0,0 +1,99 @@
+/**
+ * Copyright © 2004 - 2024, Université de Versailles Saint-Quentin-en-Yvelines (UVSQ)
+ * Copyright © 2024, Gabriel Dos Santos
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ **/
+
+#pragma once
+
+#include "types.h"
+
+/// Composite scenario of a pipeline benchmark, chaining two routines the way parsers do.
+typedef enum pipeline_scenario_e {
+    /// CSV tokenizing: `strchr` finds the end of each line and field, `memcpy` extracts them.
+    PIPELINE_CSV,
+    /// Key-value lookup: `strlen` measures each query, `memcmp` compares it to keys of the table.
+    PIPELINE_KV,
+    /// Path manipulation: `strrchr` finds the last `/` and `.`, `strcpy` splits the path.
+    PIPELINE_PATH,
+} pipeline_scenario_t;
+
+/// Number of pipeline scenarios.
+#define PIPELINE_NSCENARIOS 3
+
+/// Entry of the hash table of the key-value lookup scenario.
+typedef struct pipeline_entry_s {
+    char const* key;
+    size_t len;
+    size_t value;
+} pipeline_entry_t;
+
+/// Generated corpus of a pipeline scenario.
+typedef struct pipeline_corpus_s {
+    pipeline_scenario_t scenario;
+    /// Records, stored one after the other (lines of CSV, NUL-terminated queries or paths).
+    char* text;
+    /// Size of the text (in bytes).
+    size_t size;
+    /// Start of each record in `text`.
+    char const** records;
+    size_t nrecords;
+    /// Hash table of the key-value lookup scenario: entries of bucket `h` are the ones from
+    /// `buckets[h]` to `buckets[h + 1]`.
+    pipeline_entry_t* entries;
+    size_t* buckets;
+    size_t nbuckets;
+    char* keys;
+    /// Scratch buffers the stages write to (a line or field, and a path component).
+    char* scratch;
+    char* scratch2;
+} pipeline_corpus_t;
+
+/// Generates a random corpus of `nrecords` records of `scenario`.
+pipeline_corpus_t pipeline_corpus_init(pipeline_scenario_t scenario, size_t nrecords);
+
+/// Frees a corpus generated by `pipeline_corpus_init`.
+void pipeline_corpus_free(pipeline_corpus_t corpus[static 1]);
+
+/// Runs a pipeline over a whole corpus.
+/// Returns a checksum of the result, identical for all the stage implementations of a scenario.
+typedef size_t pipeline_fn_t(pipeline_corpus_t const* corpus);
+
+/// Stage implementations each pipeline is built with: every combination of GNU libc (`libc`), the
+/// Arm optimized-routines kernels (`arm`) and the new kernels (`new`), the first stage first.
+#define PIPELINE_STAGES(X, scenario)                                                               \
+    X(scenario, libc, libc)                                                                        \
+    X(scenario, libc, arm)                                                                         \
+    X(scenario, libc, new)                                                                         \
+    X(scenario, arm, libc)                                                                         \
+    X(scenario, arm, arm)                                                                          \
+    X(scenario, arm, new)                                                                          \
+    X(scenario, new, libc)                                                                         \
+    X(scenario, new, arm)                                                                          \
+    X(scenario, new, new)
+
+/// Number of stage implementations of each pipeline (see `PIPELINE_STAGES`).
+#define PIPELINE_NIMPLS 9
+
+#define PIPELINE_DECLARE(scenario, first, second)                                                  \
+    size_t pipeline_##scenario##_##first##_##second(pipeline_corpus_t const* corpus);
+
+PIPELINE_STAGES(PIPELINE_DECLARE, csv)
+PIPELINE_STAGES(PIPELINE_DECLARE, kv)
+PIPELINE_STAGES(PIPELINE_DECLARE, path)
+
+#undef PIPELINE_DECLARE
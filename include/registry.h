@@ -0,0 +1,201 @@
+/**
+ * Copyright © 2004 - 2024, Université de Versailles Saint-Quentin-en-Yvelines (UVSQ)
+ * Copyright © 2024, Gabriel Dos Santos
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ **/
+
+#pragma once
+
+#include "dispatch.h"
+#include "driver.h"
+#include "utils.h"
+
+#include <string.h>
+
+// Registries of the implementations of the routines timed on short strings, as X-macros expanding
+// `X(name, fn, features)` (see `IMPL`) for each implementation, in order. They define both the
+// `impl_t` tables of the benchmarks and their direct-call drivers (see `direct.h`).
+
+/// Entry of an `impl_t` table built from a registry.
+#define IMPL_ENTRY(name, fn, features) IMPL(name, fn, features),
+
+/// Baseline implementation of the `memcmp` benchmark (GNU libc or Arm OR).
+#ifdef CMP_LIBC
+    #define MEMCMP_BASELINE(X) X("memcmp (GNU libc 2.39)", memcmp, CPU_FEAT_NONE)
+#else
+    #define MEMCMP_BASELINE(X) X("memcmp (Arm OR 23.01)", __memcmp_aarch64_sve, CPU_FEAT_SVE)
+#endif
+/// Implementations of the `memcmp` benchmark.
+#define MEMCMP_REGISTRY(X)                                                                         \
+    MEMCMP_BASELINE(X)                                                                             \
+    X("memcmp (LI-PaRAD)", new_memcmp_aarch64_sve, CPU_FEAT_SVE)                                   \
+    X("memcmp VL128 (LI-PaRAD)", new_memcmp_aarch64_sve_vl128, CPU_FEAT_SVE | CPU_FEAT_VL128)      \
+    X("memcmp VL256 (LI-PaRAD)", new_memcmp_aarch64_sve_vl256, CPU_FEAT_SVE | CPU_FEAT_VL256)      \
+    X("memcmp (dispatch)", dispatch_memcmp, DISPATCH_MEMCMP_FEATURES)                              \
+    X("memcmp (ACLE GCC)", acle_gcc_memcmp_aarch64_sve, CPU_FEAT_SVE)                              \
+    X("memcmp (ACLE Clang)", acle_clang_memcmp_aarch64_sve, CPU_FEAT_SVE)                          \
+    X("memcmp (AdvSIMD)", advsimd_memcmp_aarch64, CPU_FEAT_NONE)                                   \
+    X("memcmp (C reference)", ref_memcmp, CPU_FEAT_NONE)
+
+/// Baseline implementation of the `memcpy` benchmark (GNU libc or Arm OR).
+#ifdef CMP_LIBC
+    #define MEMCPY_BASELINE(X) X("memcpy (GNU libc 2.39)", memcpy, CPU_FEAT_NONE)
+#else
+    #define MEMCPY_BASELINE(X) X("memcpy (Arm OR 23.01)", __memcpy_aarch64_sve, CPU_FEAT_SVE)
+#endif
+/// Implementations of the `memcpy` benchmark.
+#define MEMCPY_REGISTRY(X)                                                                         \
+    MEMCPY_BASELINE(X)                                                                             \
+    X("memcpy (LI-PaRAD)", new_memcpy_aarch64_sve, CPU_FEAT_SVE)                                   \
+    X("memcpy x2 (LI-PaRAD)", new_memcpy_x2_aarch64_sve, CPU_FEAT_SVE)                             \
+    X("memcpy x4 (LI-PaRAD)", new_memcpy_x4_aarch64_sve, CPU_FEAT_SVE)                             \
+    X("memcpy auto (LI-PaRAD)", new_memcpy_auto_aarch64_sve, CPU_FEAT_SVE)                         \
+    X("memcpy (dispatch)", dispatch_memcpy, DISPATCH_MEMCPY_FEATURES)                              \
+    X("memcpy (ACLE GCC)", acle_gcc_memcpy_aarch64_sve, CPU_FEAT_SVE)                              \
+    X("memcpy (ACLE Clang)", acle_clang_memcpy_aarch64_sve, CPU_FEAT_SVE)                          \
+    X("memcpy (AdvSIMD)", advsimd_memcpy_aarch64, CPU_FEAT_NONE)                                   \
+    X("memcpy (C reference)", ref_memcpy, CPU_FEAT_NONE)
+
+/// Baseline implementation of the `strcmp` benchmark (GNU libc or Arm OR).
+#ifdef CMP_LIBC
+    #define STRCMP_BASELINE(X) X("strcmp (GNU libc 2.39)", strcmp, CPU_FEAT_NONE)
+#else
+    #define STRCMP_BASELINE(X) X("strcmp (Arm OR 23.01)", __strcmp_aarch64_sve, CPU_FEAT_SVE)
+#endif
+/// Implementations of the `strcmp` benchmark.
+#define STRCMP_REGISTRY(X)                                                                         \
+    STRCMP_BASELINE(X)                                                                             \
+    X("strcmp (LI-PaRAD)", new_strcmp_aarch64_sve, CPU_FEAT_SVE)                                   \
+    X("strcmp VL128 (LI-PaRAD)", new_strcmp_aarch64_sve_vl128, CPU_FEAT_SVE | CPU_FEAT_VL128)      \
+    X("strcmp VL256 (LI-PaRAD)", new_strcmp_aarch64_sve_vl256, CPU_FEAT_SVE | CPU_FEAT_VL256)      \
+    X("strcmp (ACLE GCC)", acle_gcc_strcmp_aarch64_sve, CPU_FEAT_SVE)                              \
+    X("strcmp (ACLE Clang)", acle_clang_strcmp_aarch64_sve, CPU_FEAT_SVE)                          \
+    X("strcmp (AdvSIMD)", advsimd_strcmp_aarch64, CPU_FEAT_NONE)                                   \
+    X("strcmp (C reference)", ref_strcmp, CPU_FEAT_NONE)
+
+/// Baseline implementation of the `strncmp` benchmark (GNU libc or Arm OR).
+#ifdef CMP_LIBC
+    #define STRNCMP_BASELINE(X) X("strncmp (GNU libc 2.39)", strncmp, CPU_FEAT_NONE)
+#else
+    #define STRNCMP_BASELINE(X) X("strncmp (Arm OR 23.01)", __strncmp_aarch64_sve, CPU_FEAT_SVE)
+#endif
+/// Implementations of the `strncmp` benchmark.
+#define STRNCMP_REGISTRY(X)                                                                        \
+    STRNCMP_BASELINE(X)                                                                            \
+    X("strncmp (LI-PaRAD)", new_strncmp_aarch64_sve, CPU_FEAT_SVE)                                 \
+    X("strncmp VL128 (LI-PaRAD)", new_strncmp_aarch64_sve_vl128, CPU_FEAT_SVE | CPU_FEAT_VL128)    \
+    X("strncmp VL256 (LI-PaRAD)", new_strncmp_aarch64_sve_vl256, CPU_FEAT_SVE | CPU_FEAT_VL256)    \
+    X("strncmp (dispatch)", dispatch_strncmp, DISPATCH_STRNCMP_FEATURES)                           \
+    X("strncmp (ACLE GCC)", acle_gcc_strncmp_aarch64_sve, CPU_FEAT_SVE)                            \
+    X("strncmp (ACLE Clang)", acle_clang_strncmp_aarch64_sve, CPU_FEAT_SVE)                        \
+    X("strncmp (AdvSIMD)", advsimd_strncmp_aarch64, CPU_FEAT_NONE)                                 \
+    X("strncmp (C reference)", ref_strncmp, CPU_FEAT_NONE)
+
+/// Baseline implementation of the `strchr` benchmark (GNU libc or Arm OR).
+#ifdef CMP_LIBC
+    #define STRCHR_BASELINE(X) X("strchr (GNU libc 2.39)", strchr, CPU_FEAT_NONE)
+#else
+    #define STRCHR_BASELINE(X) X("strchr (Arm OR 23.01)", __strchr_aarch64_sve, CPU_FEAT_SVE)
+#endif
+/// Implementations of the `strchr` benchmark.
+#define STRCHR_REGISTRY(X)                                                                         \
+    STRCHR_BASELINE(X)                                                                             \
+    X("strchr (LI-PaRAD)", new_strchr_aarch64_sve, CPU_FEAT_SVE)                                   \
+    X("strchr SVE2 (LI-PaRAD)", new_strchr_aarch64_sve2, CPU_FEAT_SVE | CPU_FEAT_SVE2)             \
+    X("strchr (ACLE GCC)", acle_gcc_strchr_aarch64_sve, CPU_FEAT_SVE)                              \
+    X("strchr (ACLE Clang)", acle_clang_strchr_aarch64_sve, CPU_FEAT_SVE)                          \
+    X("strchr (AdvSIMD)", advsimd_strchr_aarch64, CPU_FEAT_NONE)                                   \
+    X("strchr (C reference)", ref_strchr, CPU_FEAT_NONE)
+
+/// Baseline implementation of the `strrchr` benchmark (GNU libc or Arm OR).
+#ifdef CMP_LIBC
+    #define STRRCHR_BASELINE(X) X("strrchr (GNU libc 2.39)", strrchr, CPU_FEAT_NONE)
+#else
+    #define STRRCHR_BASELINE(X) X("strrchr (Arm OR 23.01)", __strrchr_aarch64_sve, CPU_FEAT_SVE)
+#endif
+/// Implementations of the `strrchr` benchmark.
+#define STRRCHR_REGISTRY(X)                                                                        \
+    STRRCHR_BASELINE(X)                                                                            \
+    X("strrchr (LI-PaRAD)", new_strrchr_aarch64_sve, CPU_FEAT_SVE)                                 \
+    X("strrchr SVE2 (LI-PaRAD)", new_strrchr_aarch64_sve2, CPU_FEAT_SVE | CPU_FEAT_SVE2)           \
+    X("strrchr (ACLE GCC)", acle_gcc_strrchr_aarch64_sve, CPU_FEAT_SVE)                            \
+    X("strrchr (ACLE Clang)", acle_clang_strrchr_aarch64_sve, CPU_FEAT_SVE)                        \
+    X("strrchr (AdvSIMD)", advsimd_strrchr_aarch64, CPU_FEAT_NONE)                                 \
+    X("strrchr (C reference)", ref_strrchr, CPU_FEAT_NONE)
+
+/// Baseline implementation of the `strcpy` benchmark (GNU libc or Arm OR).
+#ifdef CMP_LIBC
+    #define STRCPY_BASELINE(X) X("strcpy (GNU libc 2.39)", strcpy, CPU_FEAT_NONE)
+#else
+    #define STRCPY_BASELINE(X) X("strcpy (Arm OR 23.01)", __strcpy_aarch64_sve, CPU_FEAT_SVE)
+#endif
+/// Implementations of the `strcpy` benchmark.
+#define STRCPY_REGISTRY(X)                                                                         \
+    STRCPY_BASELINE(X)                                                                             \
+    X("strcpy (LI-PaRAD)", new_strcpy_aarch64_sve, CPU_FEAT_SVE)                                   \
+    X("strcpy (ACLE GCC)", acle_gcc_strcpy_aarch64_sve, CPU_FEAT_SVE)                              \
+    X("strcpy (ACLE Clang)", acle_clang_strcpy_aarch64_sve, CPU_FEAT_SVE)                          \
+    X("strcpy (AdvSIMD)", advsimd_strcpy_aarch64, CPU_FEAT_NONE)                                   \
+    X("strcpy (C reference)", ref_strcpy, CPU_FEAT_NONE)
+
+/// Implementations of the `strncpy` benchmark.
+#define STRNCPY_REGISTRY(X)                                                                        \
+    X("strncpy (GNU libc 2.39)", strncpy, CPU_FEAT_NONE)                                           \
+    X("strncpy (LI-PaRAD)", new_strncpy_aarch64_sve, CPU_FEAT_SVE)                                 \
+    X("strncpy (dispatch)", dispatch_strncpy, DISPATCH_STRNCPY_FEATURES)                           \
+    X("strncpy (ACLE GCC)", acle_gcc_strncpy_aarch64_sve, CPU_FEAT_SVE)                            \
+    X("strncpy (ACLE Clang)", acle_clang_strncpy_aarch64_sve, CPU_FEAT_SVE)                        \
+    X("strncpy (AdvSIMD)", advsimd_strncpy_aarch64, CPU_FEAT_NONE)                                 \
+    X("strncpy (C reference)", ref_strncpy, CPU_FEAT_NONE)
+
+/// Baseline implementation of the `strlen` benchmark (GNU libc or Arm OR).
+#ifdef CMP_LIBC
+    #define STRLEN_BASELINE(X) X("strlen (GNU libc 2.39)", strlen, CPU_FEAT_NONE)
+#else
+    #define STRLEN_BASELINE(X) X("strlen (Arm OR 23.01)", __strlen_aarch64_sve, CPU_FEAT_SVE)
+#endif
+/// Implementations of the `strlen` benchmark.
+#define STRLEN_REGISTRY(X)                                                                         \
+    STRLEN_BASELINE(X)                                                                             \
+    X("strlen (LI-PaRAD)", new_strlen_aarch64_sve, CPU_FEAT_SVE)                                   \
+    X("strlen VL128 (LI-PaRAD)", new_strlen_aarch64_sve_vl128, CPU_FEAT_SVE | CPU_FEAT_VL128)      \
+    X("strlen VL256 (LI-PaRAD)", new_strlen_aarch64_sve_vl256, CPU_FEAT_SVE | CPU_FEAT_VL256)      \
+    X("strlen x2 (LI-PaRAD)", new_strlen_x2_aarch64_sve, CPU_FEAT_SVE)                             \
+    X("strlen x4 (LI-PaRAD)", new_strlen_x4_aarch64_sve, CPU_FEAT_SVE)                             \
+    X("strlen auto (LI-PaRAD)", new_strlen_auto_aarch64_sve, CPU_FEAT_SVE)                         \
+    X("strlen (ACLE GCC)", acle_gcc_strlen_aarch64_sve, CPU_FEAT_SVE)                              \
+    X("strlen (ACLE Clang)", acle_clang_strlen_aarch64_sve, CPU_FEAT_SVE)                          \
+    X("strlen (AdvSIMD)", advsimd_strlen_aarch64, CPU_FEAT_NONE)                                   \
+    X("strlen (C reference)", ref_strlen, CPU_FEAT_NONE)
+
+/// Baseline implementation of the `strnlen` benchmark (GNU libc or Arm OR).
+#ifdef CMP_LIBC
+    #define STRNLEN_BASELINE(X) X("strnlen (GNU libc 2.39)", strnlen, CPU_FEAT_NONE)
+#else
+    #define STRNLEN_BASELINE(X) X("strnlen (Arm OR 23.01)", __strnlen_aarch64_sve, CPU_FEAT_SVE)
+#endif
+/// Implementations of the `strnlen` benchmark.
+#define STRNLEN_REGISTRY(X)                                                                        \
+    STRNLEN_BASELINE(X)                                                                            \
+    X("strnlen (LI-PaRAD)", new_strnlen_aarch64_sve, CPU_FEAT_SVE)                                 \
+    X("strnlen VL128 (LI-PaRAD)", new_strnlen_aarch64_sve_vl128, CPU_FEAT_SVE | CPU_FEAT_VL128)    \
+    X("strnlen VL256 (LI-PaRAD)", new_strnlen_aarch64_sve_vl256, CPU_FEAT_SVE | CPU_FEAT_VL256)    \
+    X("strnlen (dispatch)", dispatch_strnlen, DISPATCH_STRNLEN_FEATURES)                           \
+    X("strnlen (ACLE GCC)", acle_gcc_strnlen_aarch64_sve, CPU_FEAT_SVE)                            \
+    X("strnlen (ACLE Clang)", acle_clang_strnlen_aarch64_sve, CPU_FEAT_SVE)                        \
+    X("strnlen (AdvSIMD)", advsimd_strnlen_aarch64, CPU_FEAT_NONE)                                 \
+    X("strnlen (C reference)", ref_strnlen, CPU_FEAT_NONE)
@@ -0,0 +1,45 @@
+/**
+ * Copyright © 2004 - 2024, Université de Versailles Saint-Quentin-en-Yvelines (UVSQ)
+ * Copyright © 2024, Gabriel Dos Santos
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ **/
+
+#pragma once
+
+#include "bench.h"
+#include "types.h"
+
+/// Levels of the memory hierarchy of the roofline: L1, L2 and L3 caches, then DRAM.
+#define ROOFLINE_NLEVELS 4
+
+/// Number of timed passes of each calibration kernel, of which the fastest one is kept.
+#define ROOFLINE_NTRIALS 11
+
+// SVE streaming kernels of the calibration (`string/aarch64/roofline/stream-sve.S`)
+extern uint64_t stream_read_aarch64_sve(void const* src, size_t n);
+extern void stream_write_aarch64_sve(void* dst, size_t n);
+extern void stream_copy_aarch64_sve(void* restrict dst, void const* restrict src, size_t n);
+
+/// Measures the read, write and copy bandwidths achievable on each level of the memory hierarchy
+/// with the streaming kernels (working sets of half of each cache, and four times the last level
+/// cache for DRAM), and prints them. Results of the benchmarks run afterwards are then reported
+/// as a percentage of the roofline matching their memory traffic and working set.
+void roofline_calibrate(void);
+
+/// Percentage of the roofline reached by implementation `i` of a processed benchmark, or a
+/// negative value if the roofline is not calibrated or the routine does not have a matching one.
+double roofline_percent(benchmark_t const bench[static 1], size_t i);
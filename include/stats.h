@@ -36,8 +36,19 @@ typedef struct statistics_s {
     double err;
 } statistics_t;
 
+/// Statistics of the paired differences between two sets of samples.
+typedef struct paired_s {
+    /// Mean of the differences (in ns).
+    double avg;
+    /// Half-width of the 95% confidence interval of the mean difference (in ns).
+    double ci95;
+} paired_t;
+
 /// Computes the mean of a set of data of size `n`.
 double mean(size_t n, double const d[n]);
 
 /// Computes the standard deviation of a set of data of size `n`.
 double stddev(size_t n, double const d[n], double mean);
+
+/// Computes the statistics of the paired differences `b[i] - a[i]` of two sets of data of size `n`.
+paired_t paired_diff(size_t n, double const a[n], double const b[n]);
@@ -24,6 +24,37 @@
 
 #include <time.h>
 
+/// Number of bytes in a GiB (as `double`, for bandwidths in GiB/s).
+#define ONE_GIB (double)(1024 << 20)
+
+/// CPU features that routine implementations may require.
+typedef enum cpu_feature_e {
+    /// Base AArch64 (always available).
+    CPU_FEAT_NONE = 0,
+    /// Scalable Vector Extension.
+    CPU_FEAT_SVE = 1 << 0,
+    /// Scalable Vector Extension 2.
+    CPU_FEAT_SVE2 = 1 << 1,
+    /// SVE with 128-bit vectors (fixed-VL kernels).
+    CPU_FEAT_VL128 = 1 << 2,
+    /// SVE with 256-bit vectors (fixed-VL kernels).
+    CPU_FEAT_VL256 = 1 << 3,
+} cpu_feature_t;
+
+/// Returns the set of `cpu_feature_t` supported by the running CPU.
+uint32_t cpu_features(void);
+
+/// Reads the first line of a sysfs (or procfs) file into `buf`, without the newline.
+/// Returns `false` if it cannot be read.
+bool read_sysfs(char const* path, size_t n, char buf[n]);
+
+/// Probes the sizes of the L1, L2 and L3 data (or unified) caches of CPU 0 from sysfs (in bytes, 0
+/// for a level that is absent).
+void cache_sizes(size_t sizes[static 3]);
+
+/// Maximum frequency of CPU 0 from sysfs (in GHz), 0 if unknown.
+double cpu_freq_ghz(void);
+
 /// Compute elapsed time in nanoseconds between two `struct timespec` points in time.
 double elapsed_ns(struct timespec a, struct timespec b);
 
@@ -39,6 +70,26 @@ void init_buf_rand(size_t n, char* buf, bool is_str);
 /// Buffer copy helper.
 void init_buf_copy(size_t n, char* buf_dst, char const* buf_src);
 
+/// Buffer copy helper that swaps the case of ASCII letters.
+void init_buf_swapcase(size_t n, char* buf_dst, char const* buf_src);
+
+/// Random wide string initialization helper (non-null Unicode scalar values).
+void init_wbuf_rand(size_t n, wchar_t* buf);
+
+/// Text corpora of the UTF-8 benchmarks.
+typedef enum utf8_corpus_e {
+    /// ASCII characters only.
+    UTF8_ASCII,
+    /// Mostly ASCII, with accented Latin letters, CJK ideographs and emojis (2 to 4 bytes).
+    UTF8_MIXED,
+    /// Mostly CJK ideographs (3 bytes), with some ASCII.
+    UTF8_CJK,
+} utf8_corpus_t;
+
+/// Random UTF-8 buffer initialization helper (whole code points, padded with ASCII).
+/// Returns the number of code points written.
+size_t init_buf_utf8(size_t n, char* buf, utf8_corpus_t corpus);
+
 /// Prints program help.
 void help(void);
 
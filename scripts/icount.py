@@ -0,0 +1,101 @@
+import argparse
+import csv
+import os
+import sys
+
+KEY = ["ROUTINE IMPLEMENTATION", "BUF SIZE B", "VL B"]
+METRICS = ["INSNS", "LOADS", "STORES", "BYTES", "VEC BYTES"]
+
+
+def read_regions(path):
+    # Table printed by the benchmark in `--count` mode
+    rows = []
+    with open(path) as f:
+        for line in f:
+            if line.startswith("--") or "|" not in line:
+                continue
+            cols = [c.strip() for c in line.split("|")]
+            # Only region rows (other tables may be printed, e.g. headers or reports)
+            if len(cols) < 3 or not cols[1].isdigit() or not cols[2].isdigit():
+                continue
+            rows.append((cols[0], int(cols[1]), int(cols[2])))
+    return rows
+
+
+def read_counts(path):
+    # CSV printed by the TCG plugin at exit (the log may contain other lines before it)
+    with open(path) as f:
+        lines = f.readlines()
+    start = next(i for i, l in enumerate(lines) if l.startswith("REGION,"))
+    counts = {}
+    for row in csv.DictReader(lines[start:]):
+        counts[int(row["REGION"])] = {m: int(row[m]) for m in METRICS}
+    return counts
+
+
+def join(args):
+    counts = read_counts(args.counts)
+    new_file = not os.path.exists(args.output)
+    with open(args.output, "a", newline="") as f:
+        writer = csv.writer(f)
+        if new_file:
+            writer.writerow(KEY + METRICS)
+        for name, size, region in read_regions(args.regions):
+            if region not in counts:
+                print(f"warning: no counts for `{name}` ({size} B)", file=sys.stderr)
+                continue
+            writer.writerow([name, size, args.vl] + [counts[region][m] for m in METRICS])
+
+
+def read_results(path):
+    with open(path, newline="") as f:
+        return {tuple(row[k] for k in KEY): row for row in csv.DictReader(f)}
+
+
+def read_thresholds(path):
+    thresholds = {m: 0.0 for m in METRICS}
+    if path is not None:
+        with open(path, newline="") as f:
+            for row in csv.DictReader(f):
+                thresholds[row["METRIC"]] = float(row["TOLERANCE"])
+    return thresholds
+
+
+def check(args):
+    baseline = read_results(args.baseline)
+    current = read_results(args.current)
+    thresholds = read_thresholds(args.thresholds)
+
+    regressions = 0
+    for key, row in sorted(current.items()):
+        if key not in baseline:
+            continue
+        for m in METRICS:
+            old, new = int(baseline[key][m]), int(row[m])
+            if new > old * (1.0 + thresholds[m]):
+                print(f"{key[0]} ({key[1]} B, VL {key[2]} B): {m} {old} -> {new}")
+                regressions += 1
+    if regressions > 0:
+        print(f"{regressions} regression(s) above thresholds", file=sys.stderr)
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Instruction counts of routine implementations under QEMU")
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    p = sub.add_parser("join", help="Join the regions printed by the benchmark with the plugin counts")
+    p.add_argument("--regions", required=True, help="Output of the benchmark in `--count` mode")
+    p.add_argument("--counts", required=True, help="Output of the TCG plugin")
+    p.add_argument("--vl", required=True, type=int, help="SVE vector length in bytes")
+    p.add_argument("--output", required=True, help="CSV file to append results to")
+    p.set_defaults(func=join)
+
+    p = sub.add_parser("check", help="Compare counts against a baseline")
+    p.add_argument("--baseline", required=True, help="Baseline CSV file")
+    p.add_argument("--current", required=True, help="Current CSV file")
+    p.add_argument("--thresholds", help="CSV file of relative tolerances per metric (default: exact)")
+    p.set_defaults(func=check)
+
+    args = parser.parse_args()
+    args.func(args)
@@ -0,0 +1,51 @@
+#!/bin/bash
+
+# Deterministic instruction counts of every routine implementation, per buffer size and SVE vector
+# length, using qemu-aarch64 and the TCG plugin in `scripts/qemu/icount.c`. Runs on any host.
+#
+# USAGE: scripts/icount.sh <BUILD_DIR> [VL_BYTES...]
+#
+# BUILD_DIR must contain an AArch64 build of the benchmark (possibly cross-compiled). Requires
+# qemu-aarch64 (8.0+), the QEMU plugin header (`qemu-plugin.h`) and glib. When the binary is
+# dynamically linked, set QEMU_LD_PREFIX to the AArch64 sysroot (e.g. /usr/aarch64-linux-gnu).
+
+BUILD=$1
+shift
+VLS=${@:-16 32 64}
+
+BIN=$BUILD/bench-sve-string-routines
+PLUGIN=$BUILD/libicount.so
+QEMU=${QEMU:-qemu-aarch64}
+QEMU_PLUGIN_INCLUDE=${QEMU_PLUGIN_INCLUDE:-/usr/include}
+OUT=${OUT:-results/icount/current}
+
+# Routine options of the benchmark (see `--help`), keep in sync when adding routines
+routines=(
+    memcmp strcmp strncmp strcasecmp strncasecmp memcpy strcpy strncpy strchr strrchr strlen strnlen
+    strlen-batch strcmp-batch
+    wcslen wcsnlen wcscmp wcsncmp wcschr wmemchr wcscpy wcsncpy
+    utf8-validate utf8-count
+    pipeline
+)
+
+set -e
+
+# Build the plugin
+cc -shared -fPIC -O2 $(pkg-config --cflags glib-2.0) -I$QEMU_PLUGIN_INCLUDE \
+    -o $PLUGIN scripts/qemu/icount.c
+
+mkdir -p $OUT
+for r in ${routines[*]}; do
+    rm -f $OUT/${r}.csv
+    for vl in $VLS; do
+        $QEMU -cpu max,sve-default-vector-length=$vl \
+            -plugin $PLUGIN -d plugin -D $OUT/${r}-vl${vl}.plugin \
+            $BIN --count --${r} > $OUT/${r}-vl${vl}.regions
+        python3 scripts/icount.py join \
+            --regions $OUT/${r}-vl${vl}.regions \
+            --counts $OUT/${r}-vl${vl}.plugin \
+            --vl $vl \
+            --output $OUT/${r}.csv
+        rm $OUT/${r}-vl${vl}.regions $OUT/${r}-vl${vl}.plugin
+    done
+done
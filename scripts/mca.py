@@ -0,0 +1,194 @@
+import argparse
+import glob
+import os
+import re
+import subprocess
+import sys
+
+# Static throughput model of the hot loops of the SVE kernels, using llvm-mca.
+#
+# Each `.S` file is preprocessed, and every block starting at a `L(loop...)` or numeric label and
+# ending with the first branch back to it is extracted and analysed with the requested CPU models.
+# Predictions can be joined with measured bandwidths from the benchmark output.
+
+KERNEL_DIRS = ["string/aarch64/baseline", "string/aarch64/new"]
+IMPL_SUFFIX = {"baseline": "(Arm OR 23.01)", "new": "(LI-PaRAD)"}
+# Number of input buffers a routine reads in parallel (bytes of string per vector load)
+STREAMS = {
+    "memcmp": 2, "strcmp": 2, "strncmp": 2, "strcasecmp": 2, "strncasecmp": 2, "wcscmp": 2, "wcsncmp": 2,
+}
+SVE_LOAD = re.compile(r"^\s*ld(ff|nf|nt)?1[bw]\s")
+Q_LOAD = re.compile(r"^\s*(ldr|ldur|ldp)\s+q")
+LABEL = re.compile(r"^\s*([.\w]+):")
+BRANCH = re.compile(r"^\s*(b(\.\w+)?|cbn?z|tbn?z)\s+.*?([.\w]+)\s*$")
+
+
+def preprocess(path, cc):
+    cmd = [cc, "-E", "-P", "-x", "assembler-with-cpp", "-D__aarch64__", "-D__ARM_FEATURE_SVE=1", path]
+    out = subprocess.run(cmd, check=True, capture_output=True, text=True).stdout
+    # Macros such as `ENTRY` expand to several statements on a single line
+    return [s for l in out.splitlines() for s in l.split(";")]
+
+
+def extract_loops(lines):
+    # Returns (symbol, loop label, body) for each loop of a preprocessed file. Loops start at a
+    # `L(loop...)` label or a numeric local label, and end at the first branch back to it.
+    loops = []
+    symbol = None
+    for i, line in enumerate(lines):
+        m = LABEL.match(line)
+        if m is None:
+            continue
+        label = m.group(1)
+        if label.isdigit():
+            target = label + "b"
+        elif label.startswith(".Lloop"):
+            target = label
+        else:
+            if not label.startswith(".L"):
+                symbol = label
+            continue
+        end = None
+        for j in range(i + 1, len(lines)):
+            b = BRANCH.match(lines[j])
+            if b is not None and b.group(3) == target:
+                end = j
+                break
+            l = LABEL.match(lines[j])
+            if l is not None and (l.group(1) == label or not l.group(1).startswith(".L")):
+                break
+        if end is None:
+            continue
+        # The first instruction may share its line with the label
+        first = line[m.end() :]
+        body = [l.split("//")[0].split("/*")[0].rstrip() for l in [first] + lines[i + 1 : end + 1]]
+        body = [l for l in body if l.strip() and not l.strip().startswith(".")]
+        body = [re.sub(r"\b(\d+)[bf]\b", r".Ltmp\1", l) for l in body]
+        loops.append((symbol, label[2:] if label.startswith(".L") else label, body))
+    return loops
+
+
+def loaded_bytes(body, vl):
+    # Bytes loaded by one iteration through vector registers
+    n = 0
+    for l in body:
+        if SVE_LOAD.match(l):
+            n += vl
+        elif Q_LOAD.match(l):
+            n += 32 if l.split()[0] == "ldp" else 16
+    return n
+
+
+def run_mca(mca, mcpu, body, iterations):
+    cmd = [
+        mca, "-mtriple=aarch64", f"-mcpu={mcpu}", "-mattr=+sve,+sve2",
+        f"-iterations={iterations}", "-bottleneck-analysis", "-resource-pressure",
+    ]
+    res = subprocess.run(cmd, input="\n".join(body) + "\n", capture_output=True, text=True)
+    if res.returncode != 0:
+        return None, res.stderr.strip().splitlines()[0] if res.stderr.strip() else "llvm-mca failed"
+    return res.stdout, None
+
+
+def parse_mca(out, iterations):
+    total = int(re.search(r"Total Cycles:\s+(\d+)", out).group(1))
+    rthroughput = float(re.search(r"Block RThroughput:\s+([\d.]+)", out).group(1))
+
+    # Bottlenecks reported by the bottleneck analysis (if any)
+    bottleneck = "none"
+    m = re.search(r"Throughput Bottlenecks:(.*?)\n\n", out, re.S)
+    if m is not None:
+        causes = re.findall(r"(Resource Pressure|Data Dependencies)\s+\[ ([\d.]+)% \]", m.group(1))
+        causes = [(c, float(p)) for c, p in causes if float(p) > 0.0]
+        if causes:
+            bottleneck = max(causes, key=lambda c: c[1])[0].lower()
+
+    # Resource pressure per iteration, most used resources first
+    names = dict(re.findall(r"^\[(\d+)\]\s+-\s+(\S+)", out, re.M))
+    pressure = []
+    m = re.search(r"Resource pressure per iteration:\n(.*)\n(.*)\n", out)
+    if m is not None:
+        idx = re.findall(r"\[(\d+)\]", m.group(1))
+        vals = m.group(2).split()
+        for i, v in zip(idx, vals):
+            if v != "-":
+                pressure.append((names.get(i, i), float(v)))
+    pressure.sort(key=lambda p: -p[1])
+    return total / iterations, rthroughput, bottleneck, pressure
+
+
+def read_measured(path):
+    # Benchmark output: pipe-separated table with a header line
+    rows = []
+    header = None
+    with open(path) as f:
+        for line in f:
+            if line.startswith("--") or "|" not in line:
+                continue
+            cols = [c.strip() for c in line.split("|")]
+            if header is None:
+                header = cols
+                continue
+            rows.append(dict(zip(header, cols)))
+    return rows
+
+
+def measured_bpc(measured, routine, tree, size, freq_ghz):
+    path = os.path.join(measured, f"{routine}.dat")
+    if freq_ghz is None or not os.path.exists(path):
+        return None
+    name = f"{routine} {IMPL_SUFFIX[tree]}"
+    rows = [r for r in read_measured(path) if r.get("ROUTINE IMPLEMENTATION") == name]
+    rows = [r for r in rows if int(r["BUF SIZE B"]) <= size]
+    if not rows:
+        return None
+    row = max(rows, key=lambda r: int(r["BUF SIZE B"]))
+    return float(row["BW AVG GiB/s"]) * (1 << 30) / (freq_ghz * 1.0e9)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Static throughput model of SVE kernel loops")
+    parser.add_argument("--mcpu", default="neoverse-v1,neoverse-v2", help="Comma-separated llvm-mca CPU models")
+    parser.add_argument("--mca", default="llvm-mca", help="llvm-mca executable (SVE models require LLVM 17+)")
+    parser.add_argument("--cc", default="cc", help="C preprocessor used on the `.S` files")
+    parser.add_argument("--vl", type=int, default=32, help="SVE vector length in bytes (32 on Neoverse V1)")
+    parser.add_argument("--iterations", type=int, default=100, help="Number of simulated loop iterations")
+    parser.add_argument("--measured", help="Directory of benchmark outputs (`<routine>.dat`) to join with")
+    parser.add_argument("--freq-ghz", type=float, help="Core frequency of the measured machine")
+    parser.add_argument("--size", type=int, default=16384, help="Largest buffer size of the measurements to join with")
+    parser.add_argument("files", nargs="*", help="Kernel files (default: every `baseline/` and `new/` kernel)")
+    args = parser.parse_args()
+
+    files = args.files or sorted(f for d in KERNEL_DIRS for f in glob.glob(f"{d}/*.S"))
+    cpus = args.mcpu.split(",")
+
+    print(
+        "%-40s |%-18s |%-16s |%12s |%12s |%-18s |%-52s |%12s |%12s"
+        % ("KERNEL", "LOOP", "CPU", "CYCLES/ITER", "RTHROUGHPUT", "BOTTLENECK", "TOP RESOURCES",
+           "PRED B/CYC", "MEAS B/CYC")
+    )
+    for path in files:
+        tree = os.path.basename(os.path.dirname(path))
+        routine = os.path.basename(path).split("-")[0]
+        for symbol, loop, body in extract_loops(preprocess(path, args.cc)):
+            bytes_per_iter = loaded_bytes(body, args.vl) / STREAMS.get(routine, 1)
+            meas = None
+            # Only the kernels benchmarked under the plain routine name have measurements to join
+            if args.measured is not None and symbol in (f"__{routine}_aarch64_sve", f"new_{routine}_aarch64_sve"):
+                meas = measured_bpc(args.measured, routine, tree, args.size, args.freq_ghz)
+            for cpu in cpus:
+                out, err = run_mca(args.mca, cpu, body, args.iterations)
+                if out is None:
+                    print(f"{symbol} ({loop}, {cpu}): {err}", file=sys.stderr)
+                    continue
+                cycles, rthroughput, bottleneck, pressure = parse_mca(out, args.iterations)
+                top = ", ".join(f"{n}={p:.2f}" for n, p in pressure[:3])
+                print(
+                    "%-40s |%-18s |%-16s |%12.2f |%12.2f |%-18s |%-52s |%12.2f |%12s"
+                    % (symbol, loop, cpu, cycles, rthroughput, bottleneck, top,
+                       bytes_per_iter / cycles, f"{meas:.2f}" if meas is not None else "-")
+                )
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,177 @@
+/**
+ * Copyright © 2004 - 2024, Université de Versailles Saint-Quentin-en-Yvelines (UVSQ)
+ * Copyright © 2024, Gabriel Dos Santos
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ **/
+
+// QEMU TCG plugin counting the instructions and memory accesses executed between the
+// `icount_begin` and `icount_end` markers of the benchmark harness (see `scripts/icount.sh`).
+// Each marked region is one call to a routine implementation; counts are printed as CSV at exit.
+
+#include <glib.h>
+#include <qemu-plugin.h>
+
+#include <stdbool.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+QEMU_PLUGIN_EXPORT int qemu_plugin_version = QEMU_PLUGIN_VERSION;
+
+/// Marker role of a translated instruction.
+typedef enum mark_e {
+    MARK_NONE,
+    MARK_BEGIN,
+    MARK_END,
+} mark_t;
+
+/// Static information about a translated instruction.
+typedef struct insn_info_s {
+    /// Whether the instruction belongs to a marker function.
+    mark_t mark;
+    /// Whether the instruction reads memory.
+    bool is_load;
+    /// Whether the instruction writes memory.
+    bool is_store;
+    /// Whether the instruction accesses memory through vector (Q/V/Z) registers.
+    bool is_vector;
+} insn_info_t;
+
+/// Counts of a marked region.
+typedef struct region_s {
+    uint64_t insns;
+    uint64_t loads;
+    uint64_t stores;
+    uint64_t bytes;
+    uint64_t vbytes;
+} region_t;
+
+/// Counted regions (the harness is single-threaded, so a single set of counters is enough).
+static GArray* regions;
+static bool active = false;
+
+/// Returns `true` if the operands of a disassembled instruction name a Q, V or Z register.
+static bool has_vector_operand(char const* ops) {
+    for (char const* p = ops; *p != '\0'; ++p) {
+        bool const start = p == ops || p[-1] == ' ' || p[-1] == '{';
+        if (start && (p[0] == 'q' || p[0] == 'v' || p[0] == 'z') && g_ascii_isdigit(p[1])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void vcpu_insn_exec(unsigned int vcpu_index, void* udata) {
+    (void)vcpu_index;
+    insn_info_t const* info = udata;
+    switch (info->mark) {
+        case MARK_BEGIN:
+            if (!active) {
+                region_t r = { 0 };
+                g_array_append_val(regions, r);
+                active = true;
+            }
+            return;
+        case MARK_END:
+            active = false;
+            return;
+        case MARK_NONE:
+            break;
+    }
+    if (!active) {
+        return;
+    }
+    region_t* r = &g_array_index(regions, region_t, regions->len - 1);
+    r->insns++;
+    r->loads += info->is_load;
+    r->stores += info->is_store;
+}
+
+static void vcpu_mem(
+    unsigned int vcpu_index, qemu_plugin_meminfo_t meminfo, uint64_t vaddr, void* udata
+) {
+    (void)vcpu_index;
+    (void)vaddr;
+    insn_info_t const* info = udata;
+    if (!active || info->mark != MARK_NONE) {
+        return;
+    }
+    region_t* r = &g_array_index(regions, region_t, regions->len - 1);
+    uint64_t const size = UINT64_C(1) << qemu_plugin_mem_size_shift(meminfo);
+    r->bytes += size;
+    if (info->is_vector) {
+        r->vbytes += size;
+    }
+}
+
+static void vcpu_tb_trans(qemu_plugin_id_t id, struct qemu_plugin_tb* tb) {
+    (void)id;
+    size_t const n = qemu_plugin_tb_n_insns(tb);
+    for (size_t i = 0; i < n; ++i) {
+        struct qemu_plugin_insn* insn = qemu_plugin_tb_get_insn(tb, i);
+        insn_info_t* info = g_new0(insn_info_t, 1);
+
+        char const* sym = qemu_plugin_insn_symbol(insn);
+        if (sym != NULL && strcmp(sym, "icount_begin") == 0) {
+            info->mark = MARK_BEGIN;
+        } else if (sym != NULL && strcmp(sym, "icount_end") == 0) {
+            info->mark = MARK_END;
+        }
+
+        char* disas = qemu_plugin_insn_disas(insn);
+        char const* ops = strchr(disas, ' ');
+        ops = ops != NULL ? ops + 1 : "";
+        info->is_load = g_str_has_prefix(disas, "ld");
+        info->is_store = g_str_has_prefix(disas, "st");
+        info->is_vector = (info->is_load || info->is_store) && has_vector_operand(ops);
+        g_free(disas);
+
+        qemu_plugin_register_vcpu_insn_exec_cb(insn, vcpu_insn_exec, QEMU_PLUGIN_CB_NO_REGS, info);
+        if (info->is_load || info->is_store) {
+            qemu_plugin_register_vcpu_mem_cb(
+                insn, vcpu_mem, QEMU_PLUGIN_CB_NO_REGS, QEMU_PLUGIN_MEM_RW, info
+            );
+        }
+    }
+}
+
+static void plugin_exit(qemu_plugin_id_t id, void* p) {
+    (void)id;
+    (void)p;
+    GString* out = g_string_new("REGION,INSNS,LOADS,STORES,BYTES,VEC BYTES\n");
+    for (guint i = 0; i < regions->len; ++i) {
+        region_t const* r = &g_array_index(regions, region_t, i);
+        g_string_append_printf(
+            out, "%u,%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 "\n",
+            i + 1, r->insns, r->loads, r->stores, r->bytes, r->vbytes
+        );
+    }
+    qemu_plugin_outs(out->str);
+    g_string_free(out, true);
+}
+
+QEMU_PLUGIN_EXPORT int qemu_plugin_install(
+    qemu_plugin_id_t id, qemu_info_t const* info, int argc, char** argv
+) {
+    (void)info;
+    (void)argc;
+    (void)argv;
+    regions = g_array_new(false, true, sizeof(region_t));
+    qemu_plugin_register_vcpu_tb_trans_cb(id, vcpu_tb_trans);
+    qemu_plugin_register_atexit_cb(id, plugin_exit, NULL);
+    return 0;
+}
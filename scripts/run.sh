@@ -3,8 +3,8 @@
 BIN=bench-sve-string-routines
 routines=(memcmp strcmp strncmp memcpy strcpy strncpy strchr strrchr strlen strnlen)
 
-for m in (shrt full); do
-    for a in (align noalign); do
+for m in shrt full; do
+    for a in align noalign; do
         for i in ${!routines[@]}; do
             j=$(($i + ${#routines[@]}))
 
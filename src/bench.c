@@ -18,84 +18,481 @@
  * USA.
  **/
 
+#define _GNU_SOURCE
+
 #include "bench.h"
+#include "corun.h"
+#include "direct.h"
+#include "model.h"
+#include "noise.h"
+#include "roofline.h"
 #include "stats.h"
 #include "utils.h"
 
+#include <assert.h>
+#include <inttypes.h>
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/// Maximum relative difference between two consecutive warmup batches in steady state.
+#ifndef WARMUP_TOLERANCE
+    #define WARMUP_TOLERANCE 0.02
+#endif
+
+/// Maximum number of warmup batches if the runtime does not stabilize.
+#ifndef WARMUP_MAX_BATCHES
+    #define WARMUP_MAX_BATCHES 100
+#endif
+
+/// Maximum number of counted calls between two printed benchmarks.
+#define ICOUNT_MAX_PENDING (4 * BENCH_MAX_IMPLS)
+
+static bool bench_icount = false;
+/// Number of counted regions so far (regions are numbered from 1, as by the counting plugin).
+static size_t icount_nregions = 0;
+/// Implementations called in the counted regions not yet printed.
+static void (*icount_pending[ICOUNT_MAX_PENDING])(void);
+static size_t icount_npending = 0;
+
+void bench_set_counting(bool counting) {
+    bench_icount = counting;
+}
+
+bool bench_counting(void) {
+    return bench_icount;
+}
+
+__attribute__((noinline)) void icount_begin(void (*fn)(void)) {
+    assert(icount_npending < ICOUNT_MAX_PENDING && "too many counted calls in benchmark");
+    icount_pending[icount_npending++] = fn;
+    icount_nregions++;
+    __asm__ volatile("" ::: "memory");
+}
+
+__attribute__((noinline)) void icount_end(void) {
+    __asm__ volatile("" ::: "memory");
+}
+
+static bool bench_lat = false;
+static FILE* latency_dump = NULL;
+static uint64_t latency_overhead = 0;
+/// Latency histograms of the implementations called since the last `bench_schedule`.
+static struct {
+    void (*fn)(void);
+    hist_t hist;
+} latency_hists[BENCH_MAX_IMPLS];
+static size_t latency_nhists = 0;
+/// Histogram of the calls that do not fit in `latency_hists` (warmup calls of other benchmarks).
+static hist_t latency_discard;
+
+void bench_set_latency(bool latency) {
+    bench_lat = latency;
+    if (latency) {
+        latency_overhead = hist_timer_overhead();
+    }
+}
+
+bool bench_latency(void) {
+    return bench_lat;
+}
+
+bool bench_set_latency_dump(char const* path) {
+    latency_dump = fopen(path, "w");
+    if (latency_dump == NULL) {
+        return false;
+    }
+    fprintf(latency_dump, "routine,buf_size,low_ns,high_ns,count\n");
+    bench_set_latency(true);
+    return true;
+}
+
+hist_t* bench_latency_hist(void (*fn)(void)) {
+    for (size_t i = 0; i < latency_nhists; ++i) {
+        if (latency_hists[i].fn == fn) {
+            return &latency_hists[i].hist;
+        }
+    }
+    if (latency_nhists == BENCH_MAX_IMPLS) {
+        return &latency_discard;
+    }
+    latency_hists[latency_nhists].fn = fn;
+    hist_reset(&latency_hists[latency_nhists].hist);
+    return &latency_hists[latency_nhists++].hist;
+}
+
+uint64_t bench_latency_overhead(void) {
+    return latency_overhead;
+}
 
-#define ONE_GIB (double)(1024 << 20)
+warmup_t bench_warmup_start(void) {
+    warmup_t w = { .prev = 0.0, .nbatches = 0, .elapsed = 0.0, .converged = false };
+    clock_gettime(CLOCK_MONOTONIC_RAW, &w.start);
+    return w;
+}
+
+bool bench_warmup_steady(warmup_t w[static 1], double batch) {
+    // A single batch is enough when counting instructions
+    bool const steady = bench_icount ||
+                        (w->nbatches > 0 && fabs(batch - w->prev) <= WARMUP_TOLERANCE * w->prev);
+    w->prev = batch;
+    w->nbatches++;
+    if (steady || w->nbatches >= WARMUP_MAX_BATCHES) {
+        struct timespec end;
+        clock_gettime(CLOCK_MONOTONIC_RAW, &end);
+        w->elapsed = elapsed_ns(w->start, end);
+        w->converged = steady;
+        return true;
+    }
+    return false;
+}
+
+static sampling_t bench_sampling = SAMPLING_RANDOM;
+
+void bench_set_sampling(sampling_t sampling) {
+    bench_sampling = sampling;
+}
+
+bool bench_parse_sampling(char const* name, sampling_t sampling[static 1]) {
+    static struct {
+        char const* name;
+        sampling_t sampling;
+    } const names[] = {
+        { "blocked", SAMPLING_BLOCKED },
+        { "abab", SAMPLING_ALTERNATE },
+        { "abba", SAMPLING_MIRRORED },
+        { "random", SAMPLING_RANDOM },
+    };
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); ++i) {
+        if (strcmp(name, names[i].name) == 0) {
+            *sampling = names[i].sampling;
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t bench_schedule(size_t nimpls, size_t nsamples, sample_slot_t slots[nimpls * nsamples]) {
+    assert(nimpls <= BENCH_MAX_IMPLS && "too many implementations in benchmark");
+    // Only record the latencies of the scheduled calls (not the warmup or checks)
+    latency_nhists = 0;
+    noise_reset();
+    size_t n = 0;
+    // A single sample of each implementation is enough when counting instructions
+    if (bench_icount) {
+        for (size_t i = 0; i < nimpls; ++i) {
+            slots[n++] = (sample_slot_t){ .impl = i, .sample = 0 };
+        }
+        return n;
+    }
+    if (bench_sampling == SAMPLING_BLOCKED) {
+        for (size_t i = 0; i < nimpls; ++i) {
+            for (size_t e = 0; e < nsamples; ++e) {
+                slots[n++] = (sample_slot_t){ .impl = i, .sample = e };
+            }
+        }
+        return n;
+    }
+
+    size_t order[BENCH_MAX_IMPLS];
+    for (size_t e = 0; e < nsamples; ++e) {
+        for (size_t i = 0; i < nimpls; ++i) {
+            order[i] = i;
+        }
+        if (bench_sampling == SAMPLING_MIRRORED && e % 2 == 1) {
+            for (size_t i = 0; i < nimpls; ++i) {
+                order[i] = nimpls - 1 - i;
+            }
+        } else if (bench_sampling == SAMPLING_RANDOM) {
+            // Fisher-Yates shuffle
+            for (size_t i = nimpls; i > 1; --i) {
+                size_t const j = (size_t)rand() % i;
+                size_t const tmp = order[i - 1];
+                order[i - 1] = order[j];
+                order[j] = tmp;
+            }
+        }
+        for (size_t i = 0; i < nimpls; ++i) {
+            slots[n++] = (sample_slot_t){ .impl = order[i], .sample = e };
+        }
+    }
+    return n;
+}
+
+size_t bench_select(size_t n, impl_t const registry[n], impl_t impls[BENCH_MAX_IMPLS]) {
+    uint32_t const features = cpu_features();
+    size_t nimpls = 0;
+    for (size_t i = 0; i < n; ++i) {
+        // Weak symbols of implementations that were not built (e.g. ACLE kernels of another compiler)
+        if (registry[i].fn == NULL) {
+            fprintf(stderr, "Skipping `%s`: not built\n", registry[i].name);
+            continue;
+        }
+        if ((registry[i].features & features) != registry[i].features) {
+            fprintf(stderr, "Skipping `%s`: not supported by this CPU\n", registry[i].name);
+            continue;
+        }
+        assert(nimpls < BENCH_MAX_IMPLS && "too many implementations in benchmark");
+        impls[nimpls++] = registry[i];
+    }
+    return nimpls;
+}
+
+/// Computes the statistics of a set of samples (sorts them in place).
+static void compute_stats(statistics_t stats[static 1], size_t n, double d[n], bool rel_err) {
+    qsort(d, n, sizeof(double), cmp_double);
+    stats->min = d[0];
+    stats->med = d[n / 2 + 1];
+    stats->max = d[n - 1];
+    stats->avg = mean(n, d);
+    stats->err = stddev(n, d, stats->avg);
+    if (rel_err) {
+        stats->err = stats->err * 100.0 / stats->avg;
+    }
+}
 
-void bench_process(
-    benchmark_t self[static 1], size_t nsamples, double old[nsamples], double new[nsamples]
+/// Counts the disturbed samples of each implementation, and in `NOISE_REJECT` mode, moves the
+/// rounds in which no sample was disturbed to the front of each row (so that samples stay paired).
+/// Returns the number of samples to process.
+static size_t noise_filter(
+    benchmark_t self[static 1], size_t nsamples, double samples[][nsamples]
 ) {
-    qsort(old, nsamples, sizeof(double), cmp_double);
-    qsort(new, nsamples, sizeof(double), cmp_double);
-    self->rt_old.min = old[0];
-    self->rt_old.med = old[nsamples / 2 + 1];
-    self->rt_old.max = old[nsamples - 1];
-    self->rt_old.avg = mean(nsamples, old);
-    self->rt_old.err = stddev(nsamples, old, self->rt_old.avg) * 100.0 / self->rt_old.avg;
-    self->rt_new.min = new[0];
-    self->rt_new.med = new[nsamples / 2 + 1];
-    self->rt_new.max = new[nsamples - 1];
-    self->rt_new.avg = mean(nsamples, new);
-    self->rt_new.err = stddev(nsamples, new, self->rt_new.avg) * 100.0 / self->rt_new.avg;
-    self->rt_speedup = self->rt_old.avg / self->rt_new.avg;
-
-    double bw_old[nsamples];
-    double bw_new[nsamples];
+    self->nrejected = 0;
+    if (noise_mode() == NOISE_OFF) {
+        return nsamples;
+    }
+    size_t const n = nsamples < NOISE_MAX_SAMPLES ? nsamples : NOISE_MAX_SAMPLES;
+    bool disturbed[n];
+    memset(disturbed, 0, sizeof(disturbed));
+    for (size_t i = 0; i < self->nimpls; ++i) {
+        noise_count_t* c = &self->noise[i];
+        *c = (noise_count_t){ 0 };
+        uint8_t const* flags = noise_flags(self->impls[i].fn);
+        for (size_t e = 0; flags != NULL && e < n; ++e) {
+            c->disturbed += flags[e] != 0;
+            c->preempted += (flags[e] & NOISE_PREEMPTED) != 0;
+            c->migrated += (flags[e] & NOISE_MIGRATED) != 0;
+            c->faulted += (flags[e] & NOISE_FAULTED) != 0;
+            disturbed[e] = disturbed[e] || flags[e] != 0;
+        }
+    }
+    if (noise_mode() != NOISE_REJECT) {
+        return nsamples;
+    }
+
+    size_t nrejected = 0;
+    for (size_t e = 0; e < n; ++e) {
+        nrejected += disturbed[e];
+    }
+    // Disturbances this frequent are the state of the machine rather than outliers
+    if (nrejected > nsamples / 2) {
+        fprintf(
+            stderr, "Keeping all samples of size %zu: %zu of %zu rounds disturbed\n",
+            self->buf_size, nrejected, nsamples
+        );
+        return nsamples;
+    }
+    for (size_t i = 0; i < self->nimpls; ++i) {
+        size_t k = 0;
+        for (size_t e = 0; e < nsamples; ++e) {
+            if (e >= n || !disturbed[e]) {
+                samples[i][k++] = samples[i][e];
+            }
+        }
+    }
+    self->nrejected = nrejected;
+    return nsamples - nrejected;
+}
+
+void bench_process(benchmark_t self[static 1], size_t nsamples, double samples[][nsamples]) {
+    assert(self->nimpls <= BENCH_MAX_IMPLS && "too many implementations in benchmark");
+    if (bench_icount) {
+        return;
+    }
+    size_t const n = noise_filter(self, nsamples, samples);
+    double bw[n];
     double buf_size_gib = (double)self->buf_size / ONE_GIB;
-    for (size_t i = 0; i < nsamples; ++i) {
-        bw_old[i] = buf_size_gib / ns_to_s(old[i]);
-        bw_new[i] = buf_size_gib / ns_to_s(new[i]);
-    }
-    qsort(bw_old, nsamples, sizeof(double), cmp_double);
-    qsort(bw_new, nsamples, sizeof(double), cmp_double);
-    self->bw_old.min = bw_old[0];
-    self->bw_old.med = bw_old[nsamples / 2 + 1];
-    self->bw_old.max = bw_old[nsamples - 1];
-    self->bw_old.avg = mean(nsamples, bw_old);
-    self->bw_old.err = stddev(nsamples, bw_old, self->bw_old.avg);
-    self->bw_new.min = bw_new[0];
-    self->bw_new.med = bw_new[nsamples / 2 + 1];
-    self->bw_new.max = bw_new[nsamples - 1];
-    self->bw_new.avg = mean(nsamples, bw_new);
-    self->bw_new.err = stddev(nsamples, bw_new, self->bw_new.avg);
-    self->bw_speedup = 1.0 / (self->bw_old.avg / self->bw_new.avg);
+    // Paired differences must be computed before samples get sorted
+    for (size_t i = 0; i < self->nimpls; ++i) {
+        self->rt_diff[i] = paired_diff(n, samples[0], samples[i]);
+    }
+    for (size_t i = 0; i < self->nimpls; ++i) {
+        for (size_t e = 0; e < n; ++e) {
+            bw[e] = buf_size_gib / ns_to_s(samples[i][e]);
+        }
+        compute_stats(&self->rt[i], n, samples[i], true);
+        compute_stats(&self->bw[i], n, bw, false);
+        self->rt_speedup[i] = self->rt[0].avg / self->rt[i].avg;
+        self->bw_speedup[i] = 1.0 / (self->bw[0].avg / self->bw[i].avg);
+    }
+    model_record(self);
+    corun_record(self);
+    direct_record(self);
 }
 
 static inline void print_line() {
-    for (size_t i = 0; i < 17 * 7 + 14 * 2 + 31; ++i) { printf("-"); }
+    for (size_t i = 0; i < 17 * 12 + 14 * 2 + 31; ++i) { printf("-"); }
     printf("\n");
 }
 
+/// Prints the counted region of each implementation of a benchmark, to be joined with the counts
+/// reported by the instruction counting plugin.
+static void icount_print(benchmark_t const self[static 1]) {
+    static bool header = false;
+    if (!header) {
+        printf("%30s |%12s |%12s\n", "ROUTINE IMPLEMENTATION", "BUF SIZE B", "REGION");
+        header = true;
+    }
+
+    size_t const first = icount_nregions - icount_npending + 1;
+    for (size_t i = 0; i < self->nimpls; ++i) {
+        // Report the last call of each implementation (warmup calls are counted first)
+        size_t region = 0;
+        for (size_t r = 0; r < icount_npending; ++r) {
+            if (icount_pending[r] == self->impls[i].fn) {
+                region = first + r;
+            }
+        }
+        printf("%30s |%12zu |%12zu\n", self->impls[i].name, self->buf_size, region);
+    }
+    icount_npending = 0;
+}
+
+/// Prints latency percentiles of each implementation of a benchmark, and dumps their histograms.
+static void latency_print(benchmark_t const self[static 1]) {
+    static bool header = false;
+    if (!header) {
+        printf(
+            "%30s |%12s |%12s |%12s |%12s |%12s |%12s |%12s\n", "ROUTINE IMPLEMENTATION",
+            "BUF SIZE B", "CALLS", "P50 ns", "P90 ns", "P99 ns", "P99.9 ns", "MAX ns"
+        );
+        header = true;
+    }
+    print_line();
+
+    for (size_t i = 0; i < self->nimpls; ++i) {
+        hist_t const* h = NULL;
+        for (size_t j = 0; j < latency_nhists; ++j) {
+            if (latency_hists[j].fn == self->impls[i].fn) {
+                h = &latency_hists[j].hist;
+            }
+        }
+        // Implementations timed by a driver without per-call timing
+        if (h == NULL || h->total == 0) {
+            continue;
+        }
+        printf(
+            "%30s |%12zu |%12" PRIu64 " |%12.1lf |%12.1lf |%12.1lf |%12.1lf |%12.1lf\n",
+            self->impls[i].name, self->buf_size, h->total,
+            hist_ticks_to_ns(hist_percentile(h, 50.0)), hist_ticks_to_ns(hist_percentile(h, 90.0)),
+            hist_ticks_to_ns(hist_percentile(h, 99.0)), hist_ticks_to_ns(hist_percentile(h, 99.9)),
+            hist_ticks_to_ns(h->max)
+        );
+        if (latency_dump != NULL) {
+            for (size_t b = 0; b < HIST_NBUCKETS; ++b) {
+                if (h->counts[b] > 0) {
+                    fprintf(
+                        latency_dump, "%s,%zu,%.1lf,%.1lf,%" PRIu64 "\n", self->impls[i].name,
+                        self->buf_size, hist_ticks_to_ns(hist_bucket_low(b)),
+                        hist_ticks_to_ns(hist_bucket_high(b)), h->counts[b]
+                    );
+                }
+            }
+        }
+    }
+}
+
+/// Prints the implementations whose warmup stopped before their runtime stabilized (their
+/// `WARMUP us` is the time of `WARMUP_MAX_BATCHES` batches).
+static void warmup_print(benchmark_t const self[static 1]) {
+    for (size_t i = 0; i < self->nimpls; ++i) {
+        if (!self->warmup[i].converged) {
+            printf(
+                "# warmup: %s, %zu B: not steady after %zu batches\n", self->impls[i].name,
+                self->buf_size, self->warmup[i].nbatches
+            );
+        }
+    }
+}
+
+/// Prints the disturbed samples of each implementation of a benchmark as metadata lines.
+static void noise_print(benchmark_t const self[static 1]) {
+    if (noise_mode() == NOISE_OFF) {
+        return;
+    }
+    for (size_t i = 0; i < self->nimpls; ++i) {
+        noise_count_t const* c = &self->noise[i];
+        if (c->disturbed > 0) {
+            printf(
+                "# noise: %s, %zu B: %zu of %zu samples disturbed (%zu preempted, %zu migrated, "
+                "%zu faulted)\n",
+                self->impls[i].name, self->buf_size, c->disturbed, self->nsamples, c->preempted,
+                c->migrated, c->faulted
+            );
+        }
+    }
+    if (self->nrejected > 0) {
+        printf(
+            "# noise: %zu B: %zu of %zu rounds rejected\n", self->buf_size, self->nrejected,
+            self->nsamples
+        );
+    }
+}
+
 void bench_print(benchmark_t const self[static 1]) {
+    if (bench_icount) {
+        icount_print(self);
+        return;
+    }
+    if (bench_lat) {
+        latency_print(self);
+        return;
+    }
+
     static bool header = false;
     if (!header) {
         printf(
-            "%30s |%12s |%15s |%15s |%15s |%15s |%15s |%15s |%15s |%12s\n",
+            "%30s |%12s |%15s |%15s |%15s |%15s |%15s |%15s |%15s |%15s |%15s |%15s |%12s "
+            "|%15s |%15s\n",
             "ROUTINE IMPLEMENTATION", "BUF SIZE B",
             "RT MIN ns", "RT MED ns", "RT MAX ns", "RT AVG ns", "RT STDEV %",
-            "BW AVG GiB/s", "BW STDEV GiB/s",
-            "SPEEDUP"
+            "BW AVG GiB/s", "BW STDEV GiB/s", "EL AVG G/s", "ROOFLINE %", "WARMUP us",
+            "SPEEDUP", "PAIRED DIFF ns", "DIFF CI95 ns"
         );
         header = true;
     }
     print_line();
 
-    printf(
-        "%30s |%12zu |%15.3lf |%15.3lf |%15.3lf |%15.3lf |%15.3lf |%15.3lf |%15.3lf |\n",
-        self->name_old, self->buf_size,
-        self->rt_old.min, self->rt_old.med, self->rt_old.max, self->rt_old.avg, self->rt_old.err,
-        self->bw_old.avg, self->bw_old.err
-    );
-    printf(
-        "%30s |%12zu |%15.3lf |%15.3lf |%15.3lf |%15.3lf |%15.3lf |%15.3lf |%15.3lf |%+11.2lf%%\n",
-        self->name_new, self->buf_size,
-        self->rt_new.min, self->rt_new.med, self->rt_new.max, self->rt_new.avg, self->rt_new.err,
-        self->bw_new.avg, self->bw_new.err,
-        (self->rt_speedup - 1.0) * 100.0
-    );
+    // Element throughput (in billions of elements per second), bytes for byte routines
+    double const elem_size = self->nelems > 0 ? (double)self->buf_size / (double)self->nelems
+                             : self->elem_size > 0 ? (double)self->elem_size
+                                                   : 1.0;
+    for (size_t i = 0; i < self->nimpls; ++i) {
+        printf(
+            "%30s |%12zu |%15.3lf |%15.3lf |%15.3lf |%15.3lf |%15.3lf |%15.3lf |%15.3lf |%15.3lf |",
+            self->impls[i].name, self->buf_size,
+            self->rt[i].min, self->rt[i].med, self->rt[i].max, self->rt[i].avg, self->rt[i].err,
+            self->bw[i].avg, self->bw[i].err, self->bw[i].avg * ONE_GIB / elem_size * 1.0e-9
+        );
+        // Percentage of the roofline of the working set (see `roofline_calibrate`)
+        double const roof = roofline_percent(self, i);
+        if (roof >= 0.0) {
+            printf("%15.1lf |", roof);
+        } else {
+            printf("%15s |", "-");
+        }
+        printf("%15.3lf |", self->warmup[i].elapsed * 1.0e-3);
+        // Speedups and paired differences are relative to the reference implementation
+        if (i > 0) {
+            printf(
+                "%+11.2lf%% |%+15.3lf |%15.3lf",
+                (self->rt_speedup[i] - 1.0) * 100.0, self->rt_diff[i].avg, self->rt_diff[i].ci95
+            );
+        }
+        printf("\n");
+    }
+    warmup_print(self);
+    noise_print(self);
 }
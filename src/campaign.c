@@ -0,0 +1,433 @@
+/**
+ * Copyright © 2004 - 2024, Université de Versailles Saint-Quentin-en-Yvelines (UVSQ)
+ * Copyright © 2024, Gabriel Dos Santos
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ **/
+
+#define _GNU_SOURCE
+
+#include "campaign.h"
+#include "utils.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <libgen.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/prctl.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+/// Exit status of a job whose vector length is not supported by the CPU.
+#define CAMPAIGN_EXIT_VL 125
+
+/// Values of a dimension of a campaign (words of its line in the campaign file).
+typedef struct campaign_values_s {
+    char* values[CAMPAIGN_MAX_VALUES];
+    size_t n;
+} campaign_values_t;
+
+/// Cell of a campaign: a routine run by a build at a vector length.
+typedef struct campaign_cell_s {
+    char const* routine;
+    char const* build;
+    /// Vector length in bits (0 for the vector length of the CPU).
+    size_t vl;
+    /// Name of the cell (`<routine>-<build>[-vl<VL>]`).
+    char name[128];
+} campaign_cell_t;
+
+/// Physical core on which jobs are run.
+typedef struct campaign_core_s {
+    /// CPU of the core the jobs are pinned to.
+    int32_t cpu;
+    /// NUMA node of the core.
+    int32_t node;
+    /// Process of the running job (0 if idle).
+    pid_t pid;
+    /// Cell of the running job.
+    size_t cell;
+    struct timespec start;
+} campaign_core_t;
+
+/// Splits `line` into words, appended to `values`.
+static bool split(char* line, campaign_values_t values[static 1]) {
+    for (char* w = strtok(line, " \t,"); w != NULL; w = strtok(NULL, " \t,")) {
+        if (values->n == CAMPAIGN_MAX_VALUES) {
+            return false;
+        }
+        values->values[values->n++] = strdup(w);
+    }
+    return true;
+}
+
+/// Adds the CPUs of a CPU list (comma-separated CPUs and ranges, e.g. `2,4-7`) to `set`.
+static bool parse_cpu_list(char const* list, cpu_set_t set[static 1]) {
+    char const* p = list;
+    while (*p != '\0') {
+        char* end;
+        long const lo = strtol(p, &end, 10);
+        long const hi = *end == '-' ? strtol(end + 1, &end, 10) : lo;
+        if (end == p || lo < 0 || hi < lo || hi >= CPU_SETSIZE) {
+            return false;
+        }
+        for (long c = lo; c <= hi; ++c) {
+            CPU_SET(c, set);
+        }
+        p = *end == ',' ? end + 1 : end;
+        if (*p != '\0' && (*p < '0' || *p > '9')) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// NUMA node of `cpu` from sysfs (0 if unknown).
+static int32_t node_of(int32_t cpu) {
+    char path[64], list[4096];
+    for (int32_t node = 0;; ++node) {
+        snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+        if (!read_sysfs(path, sizeof(list), list)) {
+            return 0;
+        }
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (parse_cpu_list(list, &set) && CPU_ISSET(cpu, &set)) {
+            return node;
+        }
+    }
+}
+
+/// First CPU of the physical core of `cpu` from sysfs (`cpu` itself if unknown).
+static int32_t core_of(int32_t cpu) {
+    char path[96], list[64];
+    snprintf(
+        path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/thread_siblings_list", cpu
+    );
+    return read_sysfs(path, sizeof(list), list) ? (int32_t)strtol(list, NULL, 10) : cpu;
+}
+
+/// Name of a build: the directory of its binary (`self` for the running binary).
+static char const* build_name(char const* build) {
+    if (strcmp(build, "/proc/self/exe") == 0) {
+        return "self";
+    }
+    char* dir = strdup(build);
+    return basename(dirname(dir));
+}
+
+/// Reads the finished cells of the checkpoint file of a campaign. Returns the number of cells
+/// marked in `done`.
+static size_t read_checkpoint(
+    char const* path, size_t ncells, campaign_cell_t const cells[ncells], bool done[ncells]
+) {
+    FILE* f = fopen(path, "r");
+    if (f == NULL) {
+        return 0;
+    }
+    size_t ndone = 0;
+    char line[256];
+    while (fgets(line, sizeof(line), f) != NULL) {
+        line[strcspn(line, "\n")] = '\0';
+        for (size_t c = 0; c < ncells; ++c) {
+            if (!done[c] && strcmp(cells[c].name, line) == 0) {
+                done[c] = true;
+                ndone += 1;
+            }
+        }
+    }
+    fclose(f);
+    return ndone;
+}
+
+/// Starts the job of `cell` on `core`, with its results written to `<output>/<cell>.dat.tmp`.
+static pid_t start_job(
+    campaign_cell_t const cell[static 1], campaign_core_t const core[static 1], char const* output,
+    campaign_values_t const options[static 1]
+) {
+    pid_t const pid = fork();
+    if (pid != 0) {
+        return pid;
+    }
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core->cpu, &set);
+    sched_setaffinity(0, sizeof(set), &set);
+#ifdef PR_SVE_SET_VL
+    // Kept across `exec`, checked as the kernel rounds unsupported lengths down
+    if (cell->vl > 0) {
+        int32_t const vl = prctl(PR_SVE_SET_VL, cell->vl / 8 | PR_SVE_VL_INHERIT);
+        if (vl < 0 || (size_t)(vl & PR_SVE_VL_LEN_MASK) != cell->vl / 8) {
+            _exit(CAMPAIGN_EXIT_VL);
+        }
+    }
+#else
+    if (cell->vl > 0) {
+        _exit(CAMPAIGN_EXIT_VL);
+    }
+#endif
+
+    char path[4096];
+    snprintf(path, sizeof(path), "%s/%s.dat.tmp", output, cell->name);
+    int32_t const out = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    snprintf(path, sizeof(path), "%s/%s.log", output, cell->name);
+    int32_t const log = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (out < 0 || log < 0) {
+        _exit(1);
+    }
+    dup2(out, STDOUT_FILENO);
+    dup2(log, STDERR_FILENO);
+
+    char routine[64];
+    snprintf(routine, sizeof(routine), "--%s", cell->routine);
+    char* argv[CAMPAIGN_MAX_VALUES + 3];
+    size_t argc = 0;
+    argv[argc++] = (char*)cell->build;
+    for (size_t o = 0; o < options->n; ++o) {
+        argv[argc++] = options->values[o];
+    }
+    argv[argc++] = routine;
+    argv[argc] = NULL;
+    execv(cell->build, argv);
+    fprintf(stderr, "Failed to run `%s`: %s\n", cell->build, strerror(errno));
+    _exit(127);
+}
+
+/// Marks a cell as finished: moves its results in place and appends it to the checkpoint file.
+static bool finish_cell(campaign_cell_t const cell[static 1], char const* output) {
+    char tmp[4096], path[4096];
+    snprintf(tmp, sizeof(tmp), "%s/%s.dat.tmp", output, cell->name);
+    snprintf(path, sizeof(path), "%s/%s.dat", output, cell->name);
+    if (rename(tmp, path) != 0) {
+        return false;
+    }
+    snprintf(path, sizeof(path), "%s/%s", output, CAMPAIGN_CHECKPOINT);
+    int32_t const fd = open(path, O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    char line[160];
+    int32_t const len = snprintf(line, sizeof(line), "%s\n", cell->name);
+    // Synced so that a campaign interrupted right after never runs the cell again
+    bool const ok = write(fd, line, (size_t)len) == len && fsync(fd) == 0;
+    close(fd);
+    return ok;
+}
+
+bool campaign_run(char const* path) {
+    FILE* f = fopen(path, "r");
+    if (f == NULL) {
+        fprintf(stderr, "Failed to open `%s`\n", path);
+        return false;
+    }
+
+    // Campaign file
+    campaign_values_t routines = { 0 }, builds = { 0 }, vls = { 0 }, options = { 0 };
+    campaign_values_t cpus = { 0 }, bandwidth = { 0 }, output = { 0 };
+    struct {
+        char const* key;
+        campaign_values_t* values;
+    } const keys[] = {
+        { "routines", &routines }, { "builds", &builds }, { "vl", &vls },
+        { "options", &options },   { "cpus", &cpus },     { "bandwidth", &bandwidth },
+        { "output", &output },
+    };
+    char line[4096];
+    for (size_t l = 1; fgets(line, sizeof(line), f) != NULL; ++l) {
+        line[strcspn(line, "#\n")] = '\0';
+        char* colon = strchr(line, ':');
+        if (colon == NULL) {
+            if (line[strspn(line, " \t")] != '\0') {
+                fprintf(stderr, "%s:%zu: expected `<KEY>: <VALUES...>`\n", path, l);
+                return false;
+            }
+            continue;
+        }
+        *colon = '\0';
+        char* key = line + strspn(line, " \t");
+        key[strcspn(key, " \t")] = '\0';
+        size_t k = 0;
+        while (k < sizeof(keys) / sizeof(keys[0]) && strcmp(keys[k].key, key) != 0) {
+            k += 1;
+        }
+        if (k == sizeof(keys) / sizeof(keys[0]) || !split(colon + 1, keys[k].values)) {
+            fprintf(stderr, "%s:%zu: invalid key `%s` or too many values\n", path, l, key);
+            return false;
+        }
+    }
+    fclose(f);
+    if (routines.n == 0) {
+        fprintf(stderr, "%s: no routines to run\n", path);
+        return false;
+    }
+    if (builds.n == 0) {
+        split((char[]){ "/proc/self/exe" }, &builds);
+    }
+    if (vls.n == 0) {
+        split((char[]){ "0" }, &vls);
+    }
+    char const* const dir = output.n > 0 ? output.values[0] : "campaign";
+    if (mkdir(dir, 0755) != 0 && errno != EEXIST) {
+        fprintf(stderr, "Failed to create `%s`: %s\n", dir, strerror(errno));
+        return false;
+    }
+
+    // Cores: the first allowed CPU of each physical core
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (cpus.n == 0) {
+        sched_getaffinity(0, sizeof(allowed), &allowed);
+    }
+    for (size_t c = 0; c < cpus.n; ++c) {
+        if (!parse_cpu_list(cpus.values[c], &allowed)) {
+            fprintf(stderr, "%s: invalid CPU list `%s`\n", path, cpus.values[c]);
+            return false;
+        }
+    }
+    static campaign_core_t cores[CPU_SETSIZE];
+    size_t ncores = 0;
+    bool taken[CPU_SETSIZE] = { false };
+    for (int32_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (!CPU_ISSET(cpu, &allowed)) {
+            continue;
+        }
+        int32_t const core = core_of(cpu);
+        if (!taken[core]) {
+            taken[core] = true;
+            cores[ncores++] = (campaign_core_t){ .cpu = cpu, .node = node_of(cpu) };
+        }
+    }
+    if (ncores == 0) {
+        fprintf(stderr, "%s: no CPU to run on\n", path);
+        return false;
+    }
+
+    // Bandwidth exclusivity: jobs per NUMA node
+    size_t max_jobs = ncores;
+    if (bandwidth.n > 0 && strcmp(bandwidth.values[0], "exclusive") == 0) {
+        max_jobs = 1;
+    } else if (bandwidth.n > 0 && strcmp(bandwidth.values[0], "shared") != 0) {
+        char* end;
+        max_jobs = strtoull(bandwidth.values[0], &end, 10);
+        if (*end != '\0' || max_jobs == 0) {
+            fprintf(stderr, "%s: invalid bandwidth `%s`\n", path, bandwidth.values[0]);
+            return false;
+        }
+    }
+
+    // Cells, in order of the routines, then builds, then vector lengths
+    static campaign_cell_t cells[CAMPAIGN_MAX_CELLS];
+    size_t ncells = 0;
+    for (size_t r = 0; r < routines.n; ++r) {
+        for (size_t b = 0; b < builds.n; ++b) {
+            for (size_t v = 0; v < vls.n; ++v) {
+                if (ncells == CAMPAIGN_MAX_CELLS) {
+                    fprintf(stderr, "%s: more than %d cells\n", path, CAMPAIGN_MAX_CELLS);
+                    return false;
+                }
+                campaign_cell_t* cell = &cells[ncells++];
+                cell->routine = routines.values[r];
+                cell->build = builds.values[b];
+                cell->vl = strtoull(vls.values[v], NULL, 10);
+                int32_t len = snprintf(
+                    cell->name, sizeof(cell->name), "%s-%s", cell->routine,
+                    build_name(cell->build)
+                );
+                if (cell->vl > 0) {
+                    snprintf(cell->name + len, sizeof(cell->name) - len, "-vl%zu", cell->vl);
+                }
+            }
+        }
+    }
+
+    snprintf(line, sizeof(line), "%s/%s", dir, CAMPAIGN_CHECKPOINT);
+    static bool done[CAMPAIGN_MAX_CELLS];
+    size_t const ndone = read_checkpoint(line, ncells, cells, done);
+    fprintf(
+        stderr, "Campaign of %zu cells (%zu already done) on %zu cores, %zu jobs per NUMA node\n",
+        ncells, ndone, ncores, max_jobs
+    );
+
+    // Scheduling: start pending cells on idle cores of nodes below their job limit, in order
+    size_t running[CPU_SETSIZE] = { 0 };
+    size_t next = 0, nfailed = 0, nfinished = ndone;
+    while (true) {
+        for (size_t c = 0; c < ncores; ++c) {
+            while (next < ncells && done[next]) {
+                next += 1;
+            }
+            if (next == ncells) {
+                break;
+            }
+            campaign_core_t* core = &cores[c];
+            if (core->pid != 0 || running[core->node] >= max_jobs) {
+                continue;
+            }
+            core->pid = start_job(&cells[next], core, dir, &options);
+            if (core->pid < 0) {
+                fprintf(stderr, "Failed to start `%s`: %s\n", cells[next].name, strerror(errno));
+                return false;
+            }
+            core->cell = next++;
+            clock_gettime(CLOCK_MONOTONIC, &core->start);
+            running[core->node] += 1;
+        }
+
+        int32_t status;
+        pid_t const pid = wait(&status);
+        if (pid < 0) {
+            // No job left
+            break;
+        }
+        for (size_t c = 0; c < ncores; ++c) {
+            campaign_core_t* core = &cores[c];
+            if (core->pid != pid) {
+                continue;
+            }
+            struct timespec end;
+            clock_gettime(CLOCK_MONOTONIC, &end);
+            campaign_cell_t const* cell = &cells[core->cell];
+            bool const ok = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+            nfinished += 1;
+            if (ok && finish_cell(cell, dir)) {
+                fprintf(
+                    stderr, "[%zu/%zu] %s on CPU %d: done in %.1lf s\n", nfinished, ncells,
+                    cell->name, core->cpu, ns_to_s(elapsed_ns(core->start, end))
+                );
+            } else {
+                nfailed += 1;
+                fprintf(
+                    stderr, "[%zu/%zu] %s on CPU %d: %s\n", nfinished, ncells, cell->name,
+                    core->cpu,
+                    WIFEXITED(status) && WEXITSTATUS(status) == CAMPAIGN_EXIT_VL
+                        ? "vector length not supported"
+                        : "failed"
+                );
+            }
+            core->pid = 0;
+            running[core->node] -= 1;
+        }
+    }
+
+    fprintf(stderr, "Campaign finished: %zu of %zu cells failed\n", nfailed, ncells);
+    return nfailed == 0;
+}
@@ -0,0 +1,402 @@
+/**
+ * Copyright © 2004 - 2024, Université de Versailles Saint-Quentin-en-Yvelines (UVSQ)
+ * Copyright © 2024, Gabriel Dos Santos
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ **/
+
+#define _GNU_SOURCE
+
+#include "corun.h"
+#include "direct.h"
+#include "roofline.h"
+#include "utils.h"
+
+#include <assert.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/// Maximum number of results (implementation and buffer size) recorded for the slowdowns.
+#define CORUN_MAX_RESULTS 4096
+
+/// Size of a cache line (granularity of the latency hog and the LLC thrasher).
+#define CORUN_LINE 64
+
+/// Bytes streamed or touched between two checks of the duty cycle.
+#define CORUN_CHUNK (256ULL << 10)
+
+/// LLC size assumed if sysfs does not report any cache.
+#define CORUN_DEFAULT_LLC (32ULL << 20)
+
+/// Co-runner thread.
+typedef struct corun_thread_s {
+    corun_kind_t kind;
+    /// Percentage of each period the thread runs.
+    uint32_t intensity;
+    int32_t cpu;
+    pthread_t thread;
+    char* buf;
+    size_t size;
+    /// Work done (bytes streamed or touched, cache lines chased).
+    atomic_uint_fast64_t work;
+} corun_thread_t;
+
+/// Average runtimes of an implementation on a buffer size, isolated and loaded (in ns).
+typedef struct corun_result_s {
+    /// Benchmark and implementation names.
+    char const* routine;
+    char const* name;
+    size_t buf_size;
+    double isolated;
+    double loaded;
+} corun_result_t;
+
+static char const* const corun_kinds[] = { "bw", "chase", "llc" };
+
+static corun_thread_t corun_threads[CORUN_MAX_THREADS];
+static size_t corun_nthreads = 0;
+/// CPU the benchmark thread is pinned to.
+static int32_t corun_home = -1;
+
+static pthread_mutex_t corun_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t corun_cond = PTHREAD_COND_INITIALIZER;
+static atomic_bool corun_running = false;
+/// Number of co-runners with an initialized buffer.
+static atomic_size_t corun_ready = 0;
+/// Number of co-runners not paused yet.
+static atomic_size_t corun_active = 0;
+/// Time spent loaded (in ns).
+static double corun_loaded_ns = 0.0;
+static struct timespec corun_start;
+
+static corun_result_t corun_results[CORUN_MAX_RESULTS];
+static size_t corun_nresults = 0;
+
+static void pin(int32_t cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+/// Another CPU of the SMT siblings of `cpu`, or -1 if it has none.
+static int32_t sibling_of(int32_t cpu) {
+    char path[96];
+    snprintf(
+        path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/thread_siblings_list", cpu
+    );
+    FILE* f = fopen(path, "r");
+    if (f == NULL) {
+        return -1;
+    }
+    char list[64];
+    bool const ok = fgets(list, sizeof(list), f) != NULL;
+    fclose(f);
+    if (!ok) {
+        return -1;
+    }
+    // Comma-separated CPUs and ranges (e.g. `0,64` or `0-1`)
+    char* p = list;
+    while (*p != '\0' && *p != '\n') {
+        int32_t const lo = (int32_t)strtol(p, &p, 10);
+        int32_t const hi = *p == '-' ? (int32_t)strtol(p + 1, &p, 10) : lo;
+        for (int32_t c = lo; c <= hi; ++c) {
+            if (c != cpu) {
+                return c;
+            }
+        }
+        p += *p == ',';
+    }
+    return -1;
+}
+
+/// Builds a random cycle through the cache lines of the buffer of the latency hog (Sattolo).
+static void chase_init(corun_thread_t* self) {
+    size_t const n = self->size / CORUN_LINE;
+    size_t* order = malloc(n * sizeof(size_t));
+    for (size_t i = 0; i < n; ++i) {
+        order[i] = i;
+    }
+    for (size_t i = n - 1; i > 0; --i) {
+        size_t const j = ((size_t)rand() << 16 ^ (size_t)rand()) % i;
+        size_t const tmp = order[i];
+        order[i] = order[j];
+        order[j] = tmp;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        *(void**)(self->buf + order[i] * CORUN_LINE) = self->buf + order[(i + 1) % n] * CORUN_LINE;
+    }
+    free(order);
+}
+
+/// Runs a chunk of work of a co-runner from position `*pos`.
+static void corun_step(corun_thread_t* self, void** pos, size_t* off) {
+    switch (self->kind) {
+        case CORUN_BW: {
+            size_t const half = self->size / 2;
+            stream_copy_aarch64_sve(self->buf + *off, self->buf + half + *off, CORUN_CHUNK);
+            *off = *off + 2 * CORUN_CHUNK <= half ? *off + CORUN_CHUNK : 0;
+            atomic_fetch_add_explicit(&self->work, CORUN_CHUNK, memory_order_relaxed);
+            break;
+        }
+        case CORUN_CHASE: {
+            void* p = *pos;
+            for (size_t i = 0; i < CORUN_CHUNK / CORUN_LINE; ++i) {
+                p = *(void* volatile*)p;
+            }
+            *pos = p;
+            atomic_fetch_add_explicit(&self->work, CORUN_CHUNK / CORUN_LINE, memory_order_relaxed);
+            break;
+        }
+        case CORUN_LLC: {
+            volatile char* buf = self->buf;
+            for (size_t o = *off; o < *off + CORUN_CHUNK; o += CORUN_LINE) {
+                buf[o] += 1;
+            }
+            *off = *off + 2 * CORUN_CHUNK <= self->size ? *off + CORUN_CHUNK : 0;
+            atomic_fetch_add_explicit(&self->work, CORUN_CHUNK, memory_order_relaxed);
+            break;
+        }
+    }
+}
+
+static void* corun_worker(void* arg) {
+    corun_thread_t* self = arg;
+    pin(self->cpu);
+    // First touch on the CPU of the co-runner
+    memset(self->buf, 1, self->size);
+    if (self->kind == CORUN_CHASE) {
+        chase_init(self);
+    }
+    atomic_fetch_add(&corun_ready, 1);
+    void* pos = self->buf;
+    size_t off = 0;
+    double const busy = (double)CORUN_PERIOD_NS * (double)self->intensity / 100.0;
+
+    while (true) {
+        pthread_mutex_lock(&corun_mutex);
+        while (!atomic_load(&corun_running)) {
+            pthread_cond_wait(&corun_cond, &corun_mutex);
+        }
+        atomic_fetch_add(&corun_active, 1);
+        pthread_mutex_unlock(&corun_mutex);
+
+        while (atomic_load_explicit(&corun_running, memory_order_relaxed)) {
+            // Work for `intensity` percent of the period, then sleep for the rest of it
+            struct timespec start, now;
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            do {
+                corun_step(self, &pos, &off);
+                clock_gettime(CLOCK_MONOTONIC, &now);
+            } while (elapsed_ns(start, now) < busy);
+            if (self->intensity < 100) {
+                long const rest = (long)((double)CORUN_PERIOD_NS - elapsed_ns(start, now));
+                struct timespec const idle = { .tv_sec = 0, .tv_nsec = rest > 0 ? rest : 0 };
+                nanosleep(&idle, NULL);
+            }
+        }
+        atomic_fetch_sub(&corun_active, 1);
+    }
+    return NULL;
+}
+
+bool corun_add(char const* spec) {
+    // Kind
+    size_t const len = strcspn(spec, "@:");
+    size_t kind = 0;
+    while (kind < sizeof(corun_kinds) / sizeof(corun_kinds[0]) &&
+           (strlen(corun_kinds[kind]) != len || strncmp(spec, corun_kinds[kind], len) != 0)) {
+        kind += 1;
+    }
+    if (kind == sizeof(corun_kinds) / sizeof(corun_kinds[0])) {
+        return false;
+    }
+
+    // Intensity
+    char const* p = spec + len;
+    uint32_t intensity = 100;
+    if (*p == '@') {
+        char* end;
+        intensity = (uint32_t)strtoul(p + 1, &end, 10);
+        if (end == p + 1 || intensity == 0 || intensity > 100) {
+            return false;
+        }
+        p = end;
+    }
+    if (*p != ':' || p[1] == '\0') {
+        return false;
+    }
+
+    // The benchmark thread stays on its CPU, so that co-runners can be placed relative to it
+    if (corun_home < 0) {
+        corun_home = sched_getcpu();
+        pin(corun_home);
+    }
+    size_t llc = 0;
+    size_t caches[3];
+    cache_sizes(caches);
+    for (size_t l = 0; l < 3; ++l) {
+        llc = caches[l] > llc ? caches[l] : llc;
+    }
+    llc = llc > 0 ? llc : CORUN_DEFAULT_LLC;
+    size_t const size = kind == CORUN_LLC ? llc : 4 * llc > (64ULL << 20) ? 4 * llc : 64ULL << 20;
+
+    // CPUs
+    while (*p == ':' || *p == ',') {
+        p += 1;
+        int32_t cpu;
+        if (strncmp(p, "sibling", 7) == 0) {
+            cpu = sibling_of(corun_home);
+            if (cpu < 0) {
+                fprintf(stderr, "CPU %d has no SMT sibling\n", corun_home);
+                return false;
+            }
+            p += 7;
+        } else {
+            char* end;
+            cpu = (int32_t)strtol(p, &end, 10);
+            if (end == p || cpu < 0 || cpu >= CPU_SETSIZE) {
+                return false;
+            }
+            p = end;
+        }
+        if (*p != ',' && *p != '\0') {
+            return false;
+        }
+
+        assert(corun_nthreads < CORUN_MAX_THREADS && "too many co-runners");
+        corun_thread_t* self = &corun_threads[corun_nthreads++];
+        self->kind = (corun_kind_t)kind;
+        self->intensity = intensity;
+        self->cpu = cpu;
+        self->size = size;
+        self->buf = aligned_alloc(CORUN_LINE, size);
+        atomic_init(&self->work, 0);
+        if (self->buf == NULL || pthread_create(&self->thread, NULL, corun_worker, self) != 0) {
+            fprintf(stderr, "Failed to start co-runner on CPU %d\n", cpu);
+            exit(1);
+        }
+    }
+    // Buffers are initialized before any benchmark runs under load
+    while (atomic_load(&corun_ready) < corun_nthreads) {
+    }
+    return true;
+}
+
+bool corun_enabled(void) {
+    return corun_nthreads > 0;
+}
+
+void corun_set_loaded(bool loaded) {
+    if (loaded) {
+        clock_gettime(CLOCK_MONOTONIC, &corun_start);
+        pthread_mutex_lock(&corun_mutex);
+        atomic_store(&corun_running, true);
+        pthread_cond_broadcast(&corun_cond);
+        pthread_mutex_unlock(&corun_mutex);
+        printf("\nUnder the load of %zu co-runners:\n", corun_nthreads);
+    } else if (atomic_load(&corun_running)) {
+        pthread_mutex_lock(&corun_mutex);
+        atomic_store(&corun_running, false);
+        pthread_mutex_unlock(&corun_mutex);
+        // Wait for every co-runner to finish its chunk of work
+        while (atomic_load(&corun_active) > 0) {
+        }
+        struct timespec end;
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        corun_loaded_ns += elapsed_ns(corun_start, end);
+    }
+}
+
+bool corun_loaded(void) {
+    return atomic_load(&corun_running);
+}
+
+void corun_record(benchmark_t const bench[static 1]) {
+    // Call overhead reruns time implementations differently
+    if (!corun_enabled() || bench_counting() || direct_rerun()) {
+        return;
+    }
+    bool const loaded = corun_loaded();
+    // Implementations of the same name in different benchmarks (e.g. `memcpy` and `par_memcpy`)
+    char const* routine = bench->routine != NULL ? bench->routine : "";
+    for (size_t i = 0; i < bench->nimpls; ++i) {
+        corun_result_t* r = NULL;
+        for (size_t k = 0; k < corun_nresults && r == NULL; ++k) {
+            if (corun_results[k].buf_size == bench->buf_size &&
+                strcmp(corun_results[k].routine, routine) == 0 &&
+                strcmp(corun_results[k].name, bench->impls[i].name) == 0) {
+                r = &corun_results[k];
+            }
+        }
+        if (r == NULL) {
+            assert(corun_nresults < CORUN_MAX_RESULTS && "too many co-runner results");
+            r = &corun_results[corun_nresults++];
+            *r = (corun_result_t){
+                .routine = routine,
+                .name = bench->impls[i].name,
+                .buf_size = bench->buf_size,
+            };
+        }
+        if (loaded) {
+            r->loaded = bench->rt[i].avg;
+        } else {
+            r->isolated = bench->rt[i].avg;
+        }
+    }
+}
+
+void corun_report(void) {
+    if (!corun_enabled()) {
+        return;
+    }
+
+    printf("\nBenchmark thread on CPU %d\n", corun_home);
+    printf("%9s |%12s |%6s |%16s\n", "CO-RUNNER", "INTENSITY %", "CPU", "RATE");
+    for (size_t t = 0; t < corun_nthreads; ++t) {
+        corun_thread_t* self = &corun_threads[t];
+        double const work = (double)atomic_load(&self->work);
+        double const s = ns_to_s(corun_loaded_ns);
+        printf("%9s |%12u |%6d |", corun_kinds[self->kind], self->intensity, self->cpu);
+        if (s <= 0.0) {
+            printf("%16s\n", "-");
+        } else if (self->kind == CORUN_CHASE) {
+            printf("%9.3lf Mline/s\n", work / s / 1.0e6);
+        } else {
+            printf("%11.3lf GiB/s\n", work / s / (double)(1ULL << 30));
+        }
+    }
+
+    printf(
+        "\n%22s |%30s |%12s |%15s |%15s |%12s\n", "BENCHMARK", "ROUTINE IMPLEMENTATION",
+        "BUF SIZE B", "ISOLATED ns", "LOADED ns", "SLOWDOWN"
+    );
+    for (size_t k = 0; k < corun_nresults; ++k) {
+        corun_result_t const* r = &corun_results[k];
+        if (r->isolated <= 0.0 || r->loaded <= 0.0) {
+            continue;
+        }
+        printf(
+            "%22s |%30s |%12zu |%15.3lf |%15.3lf |%+11.2lf%%\n", r->routine, r->name, r->buf_size,
+            r->isolated, r->loaded, (r->loaded / r->isolated - 1.0) * 100.0
+        );
+    }
+}
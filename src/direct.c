@@ -0,0 +1,329 @@
+/**
+ * Copyright © 2004 - 2024, Université de Versailles Saint-Quentin-en-Yvelines (UVSQ)
+ * Copyright © 2024, Gabriel Dos Santos
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ **/
+
+#define _GNU_SOURCE
+
+#include "direct.h"
+#include "corun.h"
+#include "noise.h"
+#include "registry.h"
+#include "utils.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/// Calls `fn` by symbol. The result is kept, and memory is clobbered so that calls to routines
+/// declared `pure` (e.g. GNU libc `strlen`) are neither merged nor hoisted out of the loop.
+#define DIRECT_CALL(fn, ...)                                                                       \
+    do {                                                                                           \
+        __auto_type r = fn(__VA_ARGS__);                                                           \
+        __asm__ volatile("" : : "r"(r) : "memory");                                                \
+    } while (0)
+
+#define DIRECT_CALLS_1(fn, ...) DIRECT_CALL(fn, __VA_ARGS__);
+#define DIRECT_CALLS_4(fn, ...)                                                                    \
+    DIRECT_CALLS_1(fn, __VA_ARGS__)                                                                \
+    DIRECT_CALLS_1(fn, __VA_ARGS__)                                                                \
+    DIRECT_CALLS_1(fn, __VA_ARGS__)                                                                \
+    DIRECT_CALLS_1(fn, __VA_ARGS__)
+#define DIRECT_CALLS_8(fn, ...)                                                                    \
+    DIRECT_CALLS_4(fn, __VA_ARGS__)                                                                \
+    DIRECT_CALLS_4(fn, __VA_ARGS__)
+
+/// Same as the timed path of `DRIVER_BODY` (see `driver.c`), with `unroll` direct calls per loop
+/// iteration (remaining repetitions are called one at a time).
+#define DIRECT_BODY(fn, unroll, ...)                                                               \
+    bool const noisy = noise_mode() != NOISE_OFF;                                                  \
+    struct timespec a, b;                                                                          \
+    noise_t before, after;                                                                         \
+    for (size_t e = 0; e < nsamples; ++e) {                                                        \
+        if (noisy) {                                                                               \
+            before = noise_snapshot();                                                             \
+        }                                                                                          \
+        clock_gettime(CLOCK_MONOTONIC_RAW, &a);                                                    \
+        size_t i = 0;                                                                              \
+        for (; i + unroll <= nreps; i += unroll) {                                                 \
+            DIRECT_CALLS_##unroll(fn, __VA_ARGS__)                                                 \
+        }                                                                                          \
+        for (; i < nreps; ++i) {                                                                   \
+            DIRECT_CALL(fn, __VA_ARGS__);                                                          \
+        }                                                                                          \
+        clock_gettime(CLOCK_MONOTONIC_RAW, &b);                                                    \
+        samples[e] = elapsed_ns(a, b) / (double)nreps;                                             \
+        if (noisy) {                                                                               \
+            after = noise_snapshot();                                                              \
+            noise_record((void (*)(void))(fn), noise_compare(&before, &after));                    \
+        }                                                                                          \
+    }
+
+#define DIRECT_UNPAREN(...) __VA_ARGS__
+
+/// Defines the direct-call driver `direct_<routine>_<fn>_x<unroll>`, taking `params`.
+#define DIRECT_DRIVER(routine, fn, unroll, params, ...)                                            \
+    static void direct_##routine##_##fn##_x##unroll(                                               \
+        size_t nsamples, size_t nreps, double samples[nsamples], DIRECT_UNPAREN params             \
+    ) {                                                                                            \
+        DIRECT_BODY(fn, unroll, __VA_ARGS__)                                                       \
+    }
+
+/// Defines the direct-call drivers of `fn` at each unroll factor.
+#define DIRECT_DRIVERS(routine, fn, params, ...)                                                   \
+    DIRECT_DRIVER(routine, fn, 1, params, __VA_ARGS__)                                             \
+    DIRECT_DRIVER(routine, fn, 4, params, __VA_ARGS__)                                             \
+    DIRECT_DRIVER(routine, fn, 8, params, __VA_ARGS__)
+
+#define MEMCMP_DIRECT(name, fn, features)                                                          \
+    DIRECT_DRIVERS(memcmp, fn, (void const* s1, void const* s2, size_t n), s1, s2, n)
+#define MEMCPY_DIRECT(name, fn, features)                                                          \
+    DIRECT_DRIVERS(                                                                                \
+        memcpy, fn, (void* restrict dst, void const* restrict src, size_t n), dst, src, n          \
+    )
+#define STRCMP_DIRECT(name, fn, features)                                                          \
+    DIRECT_DRIVERS(strcmp, fn, (char const* s1, char const* s2), s1, s2)
+#define STRNCMP_DIRECT(name, fn, features)                                                         \
+    DIRECT_DRIVERS(strncmp, fn, (char const* s1, char const* s2, size_t n), s1, s2, n)
+#define STRCHR_DIRECT(name, fn, features)                                                          \
+    DIRECT_DRIVERS(strchr, fn, (char const* s, int32_t c), s, c)
+#define STRRCHR_DIRECT(name, fn, features)                                                         \
+    DIRECT_DRIVERS(strrchr, fn, (char const* s, int32_t c), s, c)
+#define STRCPY_DIRECT(name, fn, features)                                                          \
+    DIRECT_DRIVERS(strcpy, fn, (char* restrict dst, char const* restrict src), dst, src)
+#define STRNCPY_DIRECT(name, fn, features)                                                         \
+    DIRECT_DRIVERS(                                                                                \
+        strncpy, fn, (char* restrict dst, char const* restrict src, size_t n), dst, src, n         \
+    )
+#define STRLEN_DIRECT(name, fn, features) DIRECT_DRIVERS(strlen, fn, (char const* s), s)
+#define STRNLEN_DIRECT(name, fn, features)                                                         \
+    DIRECT_DRIVERS(strnlen, fn, (char const* s, size_t n), s, n)
+
+MEMCMP_REGISTRY(MEMCMP_DIRECT)
+MEMCPY_REGISTRY(MEMCPY_DIRECT)
+STRCMP_REGISTRY(STRCMP_DIRECT)
+STRNCMP_REGISTRY(STRNCMP_DIRECT)
+STRCHR_REGISTRY(STRCHR_DIRECT)
+STRRCHR_REGISTRY(STRRCHR_DIRECT)
+STRCPY_REGISTRY(STRCPY_DIRECT)
+STRNCPY_REGISTRY(STRNCPY_DIRECT)
+STRLEN_REGISTRY(STRLEN_DIRECT)
+STRNLEN_REGISTRY(STRNLEN_DIRECT)
+
+/// Direct-call drivers of an implementation, at each unroll factor.
+typedef struct direct_entry_s {
+    void (*fn)(void);
+    direct_driver_t drivers[DIRECT_NUNROLLS];
+} direct_entry_t;
+
+#define DIRECT_DRIVER_OF(routine, fn, unroll) (direct_driver_t) direct_##routine##_##fn##_x##unroll
+#define DIRECT_ENTRY(routine, fn)                                                                  \
+    {                                                                                              \
+        (void (*)(void))(fn),                                                                      \
+        {                                                                                          \
+            DIRECT_DRIVER_OF(routine, fn, 1),                                                      \
+            DIRECT_DRIVER_OF(routine, fn, 4),                                                      \
+            DIRECT_DRIVER_OF(routine, fn, 8),                                                      \
+        },                                                                                         \
+    },
+
+static direct_entry_t const direct_table[] = {
+#define X(name, fn, features) DIRECT_ENTRY(memcmp, fn)
+    MEMCMP_REGISTRY(X)
+#undef X
+#define X(name, fn, features) DIRECT_ENTRY(memcpy, fn)
+    MEMCPY_REGISTRY(X)
+#undef X
+#define X(name, fn, features) DIRECT_ENTRY(strcmp, fn)
+    STRCMP_REGISTRY(X)
+#undef X
+#define X(name, fn, features) DIRECT_ENTRY(strncmp, fn)
+    STRNCMP_REGISTRY(X)
+#undef X
+#define X(name, fn, features) DIRECT_ENTRY(strchr, fn)
+    STRCHR_REGISTRY(X)
+#undef X
+#define X(name, fn, features) DIRECT_ENTRY(strrchr, fn)
+    STRRCHR_REGISTRY(X)
+#undef X
+#define X(name, fn, features) DIRECT_ENTRY(strcpy, fn)
+    STRCPY_REGISTRY(X)
+#undef X
+#define X(name, fn, features) DIRECT_ENTRY(strncpy, fn)
+    STRNCPY_REGISTRY(X)
+#undef X
+#define X(name, fn, features) DIRECT_ENTRY(strlen, fn)
+    STRLEN_REGISTRY(X)
+#undef X
+#define X(name, fn, features) DIRECT_ENTRY(strnlen, fn)
+    STRNLEN_REGISTRY(X)
+#undef X
+};
+
+static size_t const direct_unrolls[DIRECT_NUNROLLS] = DIRECT_UNROLLS;
+
+/// Index of the selected unroll factor in `direct_unrolls`, -1 if direct calls are disabled.
+static int32_t direct_index = -1;
+static bool direct_report_enabled = false;
+static bool direct_rerunning = false;
+
+/// Average runtimes of an implementation on a buffer size, through its `driver_*` function and
+/// its direct-call drivers (in ns, 0 if not measured).
+typedef struct direct_result_s {
+    /// Benchmark and implementation names.
+    char const* routine;
+    char const* name;
+    void (*fn)(void);
+    size_t buf_size;
+    double indirect;
+    double direct[DIRECT_NUNROLLS];
+} direct_result_t;
+
+static direct_result_t direct_results[DIRECT_MAX_RESULTS];
+static size_t direct_nresults = 0;
+
+/// Index of `unroll` in `direct_unrolls`, -1 if it is not a supported unroll factor.
+static int32_t unroll_index(size_t unroll) {
+    for (int32_t u = 0; u < DIRECT_NUNROLLS; ++u) {
+        if (direct_unrolls[u] == unroll) {
+            return u;
+        }
+    }
+    return -1;
+}
+
+/// Direct-call drivers of `fn`, `NULL` if it has none.
+static direct_entry_t const* find_entry(void (*fn)(void)) {
+    for (size_t k = 0; k < sizeof(direct_table) / sizeof(direct_table[0]); ++k) {
+        if (direct_table[k].fn == fn) {
+            return &direct_table[k];
+        }
+    }
+    return NULL;
+}
+
+bool direct_parse_unroll(char const* arg, size_t unroll[static 1]) {
+    char* end;
+    size_t const u = strtoull(arg, &end, 10);
+    if (end == arg || *end != '\0' || unroll_index(u) < 0) {
+        return false;
+    }
+    *unroll = u;
+    return true;
+}
+
+void direct_set_unroll(size_t unroll) {
+    direct_index = unroll_index(unroll);
+}
+
+direct_driver_t direct_driver(void (*fn)(void)) {
+    // The call overhead report times the `driver_*` functions outside of its reruns
+    if (direct_index < 0 || (direct_report_enabled && !direct_rerunning) || bench_counting() ||
+        bench_latency()) {
+        return NULL;
+    }
+    direct_entry_t const* entry = find_entry(fn);
+    return entry != NULL ? entry->drivers[direct_index] : NULL;
+}
+
+void direct_set_report(bool report) {
+    direct_report_enabled = report;
+}
+
+bool direct_reporting(void) {
+    return direct_report_enabled && !bench_counting() && !bench_latency();
+}
+
+void direct_set_rerun(size_t unroll) {
+    direct_rerunning = unroll > 0;
+    direct_index = unroll_index(unroll);
+    if (direct_rerunning) {
+        printf("\nThrough direct-call drivers (unrolled x%zu):\n", unroll);
+    }
+}
+
+bool direct_rerun(void) {
+    return direct_rerunning;
+}
+
+void direct_record(benchmark_t const bench[static 1]) {
+    // Direct reruns are isolated, so are the indirect runs they are compared with
+    if (!direct_reporting() || corun_loaded()) {
+        return;
+    }
+    // Implementations of the same name in different benchmarks (e.g. `memcpy` and `par_memcpy`)
+    char const* routine = bench->routine != NULL ? bench->routine : "";
+    for (size_t i = 0; i < bench->nimpls; ++i) {
+        direct_result_t* r = NULL;
+        for (size_t k = 0; k < direct_nresults && r == NULL; ++k) {
+            if (direct_results[k].buf_size == bench->buf_size &&
+                strcmp(direct_results[k].routine, routine) == 0 &&
+                strcmp(direct_results[k].name, bench->impls[i].name) == 0) {
+                r = &direct_results[k];
+            }
+        }
+        if (r == NULL) {
+            assert(direct_nresults < DIRECT_MAX_RESULTS && "too many call overhead results");
+            r = &direct_results[direct_nresults++];
+            *r = (direct_result_t){
+                .routine = routine,
+                .name = bench->impls[i].name,
+                .fn = bench->impls[i].fn,
+                .buf_size = bench->buf_size,
+            };
+        }
+        if (direct_rerunning) {
+            r->direct[direct_index] = bench->rt[i].avg;
+        } else {
+            r->indirect = bench->rt[i].avg;
+        }
+    }
+}
+
+void direct_report(void) {
+    if (!direct_reporting() || direct_nresults == 0) {
+        return;
+    }
+
+    printf(
+        "\n%22s |%30s |%12s |%15s |%15s |%15s |%15s |%15s |%12s\n", "BENCHMARK",
+        "ROUTINE IMPLEMENTATION", "BUF SIZE B", "INDIRECT ns", "DIRECT ns", "DIRECT x4 ns",
+        "DIRECT x8 ns", "OVERHEAD ns", "DISTORTION"
+    );
+    for (size_t k = 0; k < direct_nresults; ++k) {
+        direct_result_t const* r = &direct_results[k];
+        // Implementations without a direct-call driver were timed the same way in every run
+        if (r->indirect <= 0.0 || find_entry(r->fn) == NULL) {
+            continue;
+        }
+        double best = r->direct[0];
+        for (size_t u = 1; u < DIRECT_NUNROLLS; ++u) {
+            best = r->direct[u] > 0.0 && r->direct[u] < best ? r->direct[u] : best;
+        }
+        if (best <= 0.0) {
+            continue;
+        }
+        printf(
+            "%22s |%30s |%12zu |%15.3lf |%15.3lf |%15.3lf |%15.3lf |%+15.3lf |%+11.2lf%%\n",
+            r->routine, r->name, r->buf_size, r->indirect, r->direct[0], r->direct[1], r->direct[2],
+            r->indirect - best, (r->indirect / best - 1.0) * 100.0
+        );
+    }
+}
@@ -0,0 +1,277 @@
+/**
+ * Copyright © 2004 - 2024, Université de Versailles Saint-Quentin-en-Yvelines (UVSQ)
+ * Copyright © 2024, Gabriel Dos Santos
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ **/
+
+#define _GNU_SOURCE
+
+#include "dispatch.h"
+#include "bench.h"
+#include "corun.h"
+#include "direct.h"
+#include "driver.h"
+#include "utils.h"
+
+#include <assert.h>
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// Maximum number of routines recorded for the dispatch tables.
+#define DISPATCH_MAX_ROUTINES 8
+
+/// Prefix of the symbols of the composite implementations.
+#define DISPATCH_PREFIX "dispatch_"
+
+/// Size class of a dispatch table: implementation to use for buffers up to `max_size` bytes.
+typedef struct dispatch_entry_s {
+    size_t max_size;
+    char const* symbol;
+} dispatch_entry_t;
+
+/// Results recorded for a routine over a sweep of buffer sizes.
+typedef struct dispatch_routine_s {
+    char const* routine;
+    /// Size classes of the dispatch table.
+    dispatch_entry_t entries[DISPATCH_MAX_ENTRIES];
+    size_t nentries;
+    /// CPU features required by the implementations of the dispatch table.
+    uint32_t features;
+    /// Benchmarked implementations and their total average runtime over the sweep (in ns).
+    impl_t impls[BENCH_MAX_IMPLS];
+    double total[BENCH_MAX_IMPLS];
+    size_t nimpls;
+    size_t nsizes;
+} dispatch_routine_t;
+
+static char const* dispatch_path = NULL;
+static dispatch_routine_t dispatch_routines[DISPATCH_MAX_ROUTINES];
+static size_t dispatch_nroutines = 0;
+
+static inline bool is_composite(impl_t const* impl) {
+    return strncmp(impl->symbol, DISPATCH_PREFIX, strlen(DISPATCH_PREFIX)) == 0;
+}
+
+static dispatch_routine_t* find_routine(char const* routine) {
+    for (size_t r = 0; r < dispatch_nroutines; ++r) {
+        if (strcmp(dispatch_routines[r].routine, routine) == 0) {
+            return &dispatch_routines[r];
+        }
+    }
+    assert(dispatch_nroutines < DISPATCH_MAX_ROUTINES && "too many dispatched routines");
+    dispatch_routine_t* self = &dispatch_routines[dispatch_nroutines++];
+    memset(self, 0, sizeof(*self));
+    self->routine = routine;
+    return self;
+}
+
+void dispatch_set_output(char const* path) {
+    dispatch_path = path;
+}
+
+void dispatch_record(char const* routine, benchmark_t const bench[static 1]) {
+    // Nothing was timed in instruction counting mode, and loaded runs and call overhead reruns
+    // repeat the sweep
+    if (bench_counting() || corun_loaded() || direct_rerun() || bench->nimpls == 0) {
+        return;
+    }
+
+    dispatch_routine_t* self = find_routine(routine);
+    if (self->nsizes == 0) {
+        memcpy(self->impls, bench->impls, bench->nimpls * sizeof(impl_t));
+        self->nimpls = bench->nimpls;
+    }
+    assert(self->nimpls == bench->nimpls && "implementations changed during the sweep");
+    self->nsizes += 1;
+
+    // Fastest single implementation on this size
+    size_t best = SIZE_MAX;
+    for (size_t i = 0; i < bench->nimpls; ++i) {
+        self->total[i] += bench->rt[i].avg;
+        if (is_composite(&bench->impls[i])) {
+            continue;
+        }
+        if (best == SIZE_MAX || bench->rt[i].avg < bench->rt[best].avg) {
+            best = i;
+        }
+    }
+    if (best == SIZE_MAX) {
+        return;
+    }
+
+    // Extend the last size class if it uses the same implementation
+    char const* symbol = bench->impls[best].symbol;
+    self->features |= bench->impls[best].features;
+    if (self->nentries > 0 && strcmp(self->entries[self->nentries - 1].symbol, symbol) == 0) {
+        self->entries[self->nentries - 1].max_size = bench->buf_size;
+    } else {
+        assert(self->nentries < DISPATCH_MAX_ENTRIES && "too many size classes in dispatch table");
+        self->entries[self->nentries++] = (dispatch_entry_t){ bench->buf_size, symbol };
+    }
+}
+
+void dispatch_check(char const* routine) {
+    dispatch_routine_t const* self = find_routine(routine);
+    size_t composite = SIZE_MAX;
+    for (size_t i = 0; i < self->nimpls; ++i) {
+        if (is_composite(&self->impls[i])) {
+            composite = i;
+        }
+    }
+    if (self->nsizes == 0 || composite == SIZE_MAX) {
+        return;
+    }
+
+    size_t nslower = 0;
+    printf("\n%30s |%16s |%12s\n", "ROUTINE IMPLEMENTATION", "SWEEP RT ns", "COMPOSITE");
+    for (size_t i = 0; i < self->nimpls; ++i) {
+        double const gain = (self->total[i] - self->total[composite]) / self->total[i] * 100.0;
+        if (i == composite) {
+            printf("%30s |%16.3lf |\n", self->impls[i].name, self->total[i]);
+            continue;
+        }
+        printf("%30s |%16.3lf |%+11.2lf%%\n", self->impls[i].name, self->total[i], gain);
+        nslower += self->total[composite] >= self->total[i];
+    }
+    printf(
+        "`%s` %s every single implementation over %zu buffer sizes\n",
+        self->impls[composite].name, nslower == 0 ? "beats" : "does NOT beat", self->nsizes
+    );
+}
+
+/// Writes the CPU features of `features` as a C expression of `cpu_feature_t` values.
+static void write_features(FILE* out, uint32_t features) {
+    if (features == CPU_FEAT_NONE) {
+        fprintf(out, "CPU_FEAT_NONE");
+        return;
+    }
+    fprintf(out, "(");
+    char const* sep = "";
+    if (features & CPU_FEAT_SVE) {
+        fprintf(out, "%sCPU_FEAT_SVE", sep);
+        sep = " | ";
+    }
+    if (features & CPU_FEAT_SVE2) {
+        fprintf(out, "%sCPU_FEAT_SVE2", sep);
+        sep = " | ";
+    }
+    if (features & CPU_FEAT_VL128) {
+        fprintf(out, "%sCPU_FEAT_VL128", sep);
+        sep = " | ";
+    }
+    if (features & CPU_FEAT_VL256) {
+        fprintf(out, "%sCPU_FEAT_VL256", sep);
+    }
+    fprintf(out, ")");
+}
+
+void dispatch_write(void) {
+    if (dispatch_path == NULL) {
+        return;
+    }
+
+    FILE* out = fopen(dispatch_path, "w");
+    if (out == NULL) {
+        fprintf(stderr, "Failed to open `%s`\n", dispatch_path);
+        exit(1);
+    }
+
+    fprintf(out, "// Generated by `bench-sve-string-routines --dispatch`: do not edit.\n");
+    // Identify the CPU the table was measured on
+    FILE* midr = fopen("/sys/devices/system/cpu/cpu0/regs/identification/midr_el1", "r");
+    char id[32];
+    if (midr != NULL && fgets(id, sizeof(id), midr) != NULL) {
+        id[strcspn(id, "\n")] = '\0';
+        fprintf(out, "// Measured on CPU with MIDR_EL1 %s.\n", id);
+    }
+    if (midr != NULL) {
+        fclose(midr);
+    }
+    fprintf(out, "\n#pragma once\n");
+
+    for (size_t r = 0; r < dispatch_nroutines; ++r) {
+        dispatch_routine_t const* self = &dispatch_routines[r];
+        if (self->nentries == 0) {
+            continue;
+        }
+        char name[32];
+        size_t k = 0;
+        for (; self->routine[k] != '\0' && k < sizeof(name) - 1; ++k) {
+            name[k] = (char)toupper((unsigned char)self->routine[k]);
+        }
+        name[k] = '\0';
+
+        fprintf(out, "\n#define DISPATCH_%s(X) \\\n", name);
+        for (size_t e = 0; e < self->nentries; ++e) {
+            if (e + 1 == self->nentries) {
+                fprintf(out, "    X(SIZE_MAX, %s)\n", self->entries[e].symbol);
+            } else {
+                fprintf(
+                    out, "    X(%zuULL, %s) \\\n", self->entries[e].max_size, self->entries[e].symbol
+                );
+            }
+        }
+        fprintf(out, "#define DISPATCH_%s_FEATURES ", name);
+        write_features(out, self->features);
+        fprintf(out, "\n");
+    }
+
+    fclose(out);
+}
+
+/// Utility macro calling the implementation of the size class of `n`.
+#define DISPATCH_CASE(max_size, fn)                                                                \
+    if (n <= (max_size)) {                                                                         \
+        return fn(DISPATCH_ARGS);                                                                  \
+    }
+
+void* dispatch_memcpy(void* restrict dst, void const* restrict src, size_t n) {
+#define DISPATCH_ARGS dst, src, n
+    DISPATCH_MEMCPY(DISPATCH_CASE)
+#undef DISPATCH_ARGS
+    __builtin_unreachable();
+}
+
+int32_t dispatch_memcmp(void const* s1, void const* s2, size_t n) {
+#define DISPATCH_ARGS s1, s2, n
+    DISPATCH_MEMCMP(DISPATCH_CASE)
+#undef DISPATCH_ARGS
+    __builtin_unreachable();
+}
+
+int32_t dispatch_strncmp(char const* s1, char const* s2, size_t n) {
+#define DISPATCH_ARGS s1, s2, n
+    DISPATCH_STRNCMP(DISPATCH_CASE)
+#undef DISPATCH_ARGS
+    __builtin_unreachable();
+}
+
+size_t dispatch_strnlen(char const* s, size_t n) {
+#define DISPATCH_ARGS s, n
+    DISPATCH_STRNLEN(DISPATCH_CASE)
+#undef DISPATCH_ARGS
+    __builtin_unreachable();
+}
+
+char* dispatch_strncpy(char* restrict dst, char const* restrict src, size_t n) {
+#define DISPATCH_ARGS dst, src, n
+    DISPATCH_STRNCPY(DISPATCH_CASE)
+#undef DISPATCH_ARGS
+    __builtin_unreachable();
+}
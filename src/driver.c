@@ -20,21 +20,61 @@
 
 #define _GNU_SOURCE
 
+#include "bench.h"
 #include "driver.h"
+#include "noise.h"
 #include "utils.h"
 
 #include <time.h>
 
 /// Utility macro defining the body of a driver function that benchmarks a given routine.
+/// In instruction counting mode, each sample is a single call between counting markers.
+/// In latency mode, each call is timed individually and recorded in the histogram of `fn`.
+/// Otherwise, the disturbances of each sample are recorded if they are captured (see `noise.h`).
 #define DRIVER_BODY(fn, ...)                                                                       \
+    if (bench_counting()) {                                                                        \
+        for (size_t e = 0; e < nsamples; ++e) {                                                    \
+            icount_begin((void (*)(void))(fn));                                                    \
+            fn(__VA_ARGS__);                                                                       \
+            icount_end();                                                                          \
+            samples[e] = 0.0;                                                                      \
+        }                                                                                          \
+        return;                                                                                    \
+    }                                                                                              \
+    if (bench_latency()) {                                                                         \
+        hist_t* hist = bench_latency_hist((void (*)(void))(fn));                                   \
+        uint64_t const overhead = bench_latency_overhead();                                        \
+        for (size_t e = 0; e < nsamples; ++e) {                                                    \
+            uint64_t total = 0;                                                                    \
+            for (size_t i = 0; i < nreps; ++i) {                                                   \
+                uint64_t const start = hist_ticks();                                               \
+                fn(__VA_ARGS__);                                                                   \
+                uint64_t t = hist_ticks() - start;                                                 \
+                t = t > overhead ? t - overhead : 0;                                               \
+                hist_record(hist, t);                                                              \
+                total += t;                                                                        \
+            }                                                                                      \
+            samples[e] = hist_ticks_to_ns(total) / (double)nreps;                                  \
+        }                                                                                          \
+        return;                                                                                    \
+    }                                                                                              \
+    bool const noisy = noise_mode() != NOISE_OFF;                                                  \
     struct timespec a, b;                                                                          \
+    noise_t before, after;                                                                         \
     for (size_t e = 0; e < nsamples; ++e) {                                                        \
+        if (noisy) {                                                                               \
+            before = noise_snapshot();                                                             \
+        }                                                                                          \
         clock_gettime(CLOCK_MONOTONIC_RAW, &a);                                                    \
         for (size_t i = 0; i < nreps; ++i) {                                                       \
             fn(__VA_ARGS__);                                                                       \
         }                                                                                          \
         clock_gettime(CLOCK_MONOTONIC_RAW, &b);                                                    \
         samples[e] = elapsed_ns(a, b) / (double)nreps;                                             \
+        if (noisy) {                                                                               \
+            after = noise_snapshot();                                                              \
+            noise_record((void (*)(void))(fn), noise_compare(&before, &after));                    \
+        }                                                                                          \
     }
 
 void driver_memcmp(
@@ -61,6 +101,51 @@ void driver_memcpy(
     DRIVER_BODY(memcpy_fn, dst, src, n);
 }
 
+/// Reads one word per cache line of the `n` bytes of `victim`.
+static inline uint64_t touch(size_t n, uint64_t const victim[n / sizeof(uint64_t)]) {
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n / sizeof(uint64_t); i += 64 / sizeof(uint64_t)) {
+        sum += victim[i];
+    }
+    return sum;
+}
+
+void driver_memcpy_pollution(
+    size_t nsamples,
+    double copy[nsamples],
+    double reread[nsamples],
+    memcpy_fn_t* memcpy_fn,
+    void* restrict dst,
+    void const* restrict src,
+    size_t n,
+    uint64_t const* victim,
+    size_t victim_size
+) {
+    if (bench_counting()) {
+        for (size_t e = 0; e < nsamples; ++e) {
+            icount_begin((void (*)(void))(memcpy_fn));
+            memcpy_fn(dst, src, n);
+            icount_end();
+            copy[e] = 0.0;
+            reread[e] = 0.0;
+        }
+        return;
+    }
+    // Keeps the reads of the victim from being optimized out
+    static volatile uint64_t sink;
+    struct timespec a, b, c;
+    for (size_t e = 0; e < nsamples; ++e) {
+        sink += touch(victim_size, victim);
+        clock_gettime(CLOCK_MONOTONIC_RAW, &a);
+        memcpy_fn(dst, src, n);
+        clock_gettime(CLOCK_MONOTONIC_RAW, &b);
+        sink += touch(victim_size, victim);
+        clock_gettime(CLOCK_MONOTONIC_RAW, &c);
+        copy[e] = elapsed_ns(a, b);
+        reread[e] = elapsed_ns(b, c);
+    }
+}
+
 void driver_strcmp(
     size_t nsamples,
     size_t nreps,
@@ -84,6 +169,29 @@ void driver_strncmp(
     DRIVER_BODY(strncmp_fn, s1, s2, n);
 }
 
+void driver_strcasecmp(
+    size_t nsamples,
+    size_t nreps,
+    double samples[nsamples],
+    strcasecmp_fn_t* strcasecmp_fn,
+    char const* s1,
+    char const* s2
+) {
+    DRIVER_BODY(strcasecmp_fn, s1, s2);
+}
+
+void driver_strncasecmp(
+    size_t nsamples,
+    size_t nreps,
+    double samples[nsamples],
+    strncasecmp_fn_t* strncasecmp_fn,
+    char const* s1,
+    char const* s2,
+    size_t n
+) {
+    DRIVER_BODY(strncasecmp_fn, s1, s2, n);
+}
+
 void driver_strchr(
     size_t nsamples,
     size_t nreps,
@@ -149,3 +257,150 @@ void driver_strnlen(
 ) {
     DRIVER_BODY(strnlen_fn, s, n);
 }
+
+void driver_strlen_batch(
+    size_t nsamples,
+    size_t nreps,
+    double samples[nsamples],
+    strlen_batch_fn_t* strlen_batch_fn,
+    char const* const* ptrs,
+    size_t n,
+    size_t* out
+) {
+    DRIVER_BODY(strlen_batch_fn, ptrs, n, out);
+}
+
+void driver_strcmp_batch(
+    size_t nsamples,
+    size_t nreps,
+    double samples[nsamples],
+    strcmp_batch_fn_t* strcmp_batch_fn,
+    char const* const* s1,
+    char const* const* s2,
+    size_t n,
+    int32_t* out
+) {
+    DRIVER_BODY(strcmp_batch_fn, s1, s2, n, out);
+}
+
+void driver_wcslen(
+    size_t nsamples,
+    size_t nreps,
+    double samples[nsamples],
+    wcslen_fn_t* wcslen_fn,
+    wchar_t const* s
+) {
+    DRIVER_BODY(wcslen_fn, s);
+}
+
+void driver_wcsnlen(
+    size_t nsamples,
+    size_t nreps,
+    double samples[nsamples],
+    wcsnlen_fn_t* wcsnlen_fn,
+    wchar_t const* s,
+    size_t n
+) {
+    DRIVER_BODY(wcsnlen_fn, s, n);
+}
+
+void driver_wcscmp(
+    size_t nsamples,
+    size_t nreps,
+    double samples[nsamples],
+    wcscmp_fn_t* wcscmp_fn,
+    wchar_t const* s1,
+    wchar_t const* s2
+) {
+    DRIVER_BODY(wcscmp_fn, s1, s2);
+}
+
+void driver_wcsncmp(
+    size_t nsamples,
+    size_t nreps,
+    double samples[nsamples],
+    wcsncmp_fn_t* wcsncmp_fn,
+    wchar_t const* s1,
+    wchar_t const* s2,
+    size_t n
+) {
+    DRIVER_BODY(wcsncmp_fn, s1, s2, n);
+}
+
+void driver_wcschr(
+    size_t nsamples,
+    size_t nreps,
+    double samples[nsamples],
+    wcschr_fn_t* wcschr_fn,
+    wchar_t const* s,
+    wchar_t c
+) {
+    DRIVER_BODY(wcschr_fn, s, c);
+}
+
+void driver_wmemchr(
+    size_t nsamples,
+    size_t nreps,
+    double samples[nsamples],
+    wmemchr_fn_t* wmemchr_fn,
+    wchar_t const* s,
+    wchar_t c,
+    size_t n
+) {
+    DRIVER_BODY(wmemchr_fn, s, c, n);
+}
+
+void driver_wcscpy(
+    size_t nsamples,
+    size_t nreps,
+    double samples[nsamples],
+    wcscpy_fn_t* wcscpy_fn,
+    wchar_t* dst,
+    wchar_t const* src
+) {
+    DRIVER_BODY(wcscpy_fn, dst, src);
+}
+
+void driver_wcsncpy(
+    size_t nsamples,
+    size_t nreps,
+    double samples[nsamples],
+    wcsncpy_fn_t* wcsncpy_fn,
+    wchar_t* dst,
+    wchar_t const* src,
+    size_t n
+) {
+    DRIVER_BODY(wcsncpy_fn, dst, src, n);
+}
+
+void driver_utf8_validate(
+    size_t nsamples,
+    size_t nreps,
+    double samples[nsamples],
+    utf8_validate_fn_t* utf8_validate_fn,
+    char const* s,
+    size_t n
+) {
+    DRIVER_BODY(utf8_validate_fn, s, n);
+}
+
+void driver_utf8_count_codepoints(
+    size_t nsamples,
+    size_t nreps,
+    double samples[nsamples],
+    utf8_count_codepoints_fn_t* utf8_count_codepoints_fn,
+    char const* s,
+    size_t n
+) {
+    DRIVER_BODY(utf8_count_codepoints_fn, s, n);
+}
+
+void driver_pipeline(
+    size_t nsamples,
+    size_t nreps,
+    double samples[nsamples],
+    pipeline_fn_t* pipeline_fn,
+    pipeline_corpus_t const* corpus
+) {
+    DRIVER_BODY(pipeline_fn, corpus);
+}
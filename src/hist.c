@@ -0,0 +1,79 @@
+/**
+ * Copyright © 2004 - 2024, Université de Versailles Saint-Quentin-en-Yvelines (UVSQ)
+ * Copyright © 2024, Gabriel Dos Santos
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ **/
+
+#include "hist.h"
+
+#include <string.h>
+
+void hist_reset(hist_t h[static 1]) {
+    memset(h, 0, sizeof(*h));
+}
+
+uint64_t hist_bucket_low(size_t b) {
+    if (b < 2 * HIST_HALF) {
+        return b;
+    }
+    size_t const shift = b / HIST_HALF - 1;
+    return (b - shift * HIST_HALF) << shift;
+}
+
+uint64_t hist_bucket_high(size_t b) {
+    if (b < 2 * HIST_HALF) {
+        return b;
+    }
+    size_t const shift = b / HIST_HALF - 1;
+    return ((b - shift * HIST_HALF + 1) << shift) - 1;
+}
+
+uint64_t hist_percentile(hist_t const h[static 1], double p) {
+    if (h->total == 0) {
+        return 0;
+    }
+    // Rank of the value (1-based), rounded up
+    uint64_t rank = (uint64_t)(p / 100.0 * (double)h->total);
+    rank = rank < h->total ? rank + 1 : h->total;
+    uint64_t seen = 0;
+    for (size_t b = 0; b < HIST_NBUCKETS; ++b) {
+        seen += h->counts[b];
+        if (seen >= rank) {
+            uint64_t const high = hist_bucket_high(b);
+            return high < h->max ? high : h->max;
+        }
+    }
+    return h->max;
+}
+
+uint64_t hist_timer_overhead(void) {
+    uint64_t overhead = UINT64_MAX;
+    for (size_t i = 0; i < 1000; ++i) {
+        uint64_t const a = hist_ticks();
+        uint64_t const b = hist_ticks();
+        overhead = b - a < overhead ? b - a : overhead;
+    }
+    return overhead;
+}
+
+double hist_ticks_to_ns(uint64_t ticks) {
+    static double ns_per_tick = 0.0;
+    if (ns_per_tick == 0.0) {
+        ns_per_tick = 1.0e9 / (double)hist_freq();
+    }
+    return (double)ticks * ns_per_tick;
+}
@@ -18,20 +18,36 @@
  * USA.
  **/
 
-#ifdef __ARM_FEATURE_SVE
+#ifdef __aarch64__
 
 #define _GNU_SOURCE
 
 #include "bench.h"
+#include "campaign.h"
+#include "corun.h"
+#include "direct.h"
+#include "dispatch.h"
 #include "driver.h"
+#include "model.h"
+#include "noise.h"
+#include "par.h"
+#include "pipeline.h"
+#include "registry.h"
+#include "roofline.h"
 #include "types.h"
 #include "utils.h"
+#include "variants.h"
 
 #include <assert.h>
 #include <getopt.h>
+#include <locale.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <strings.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <wchar.h>
 
 // Align memory allocations if specified
 #if defined(ALIGNED_ALLOCS)
@@ -50,26 +66,126 @@
 #define SMALL_STR
 #endif
 
-static inline size_t determine_warmup_cnt(size_t bench_reps) {
+/// Long-only options (wide-character, UTF-8 and pipeline benchmarks), out of the range of short
+/// options.
+enum {
+    OPT_WCSLEN = 256,
+    OPT_WCSNLEN,
+    OPT_WCSCMP,
+    OPT_WCSNCMP,
+    OPT_WCSCHR,
+    OPT_WMEMCHR,
+    OPT_WCSCPY,
+    OPT_WCSNCPY,
+    OPT_UTF8_VALIDATE,
+    OPT_UTF8_COUNT,
+    OPT_PIPELINE,
+    OPT_LATENCY_DUMP,
+    OPT_CORUN,
+    OPT_DIRECT,
+    OPT_CALL_OVERHEAD,
+    OPT_CAMPAIGN,
+};
+
+/// Times `fn` with the direct-call driver of `routine` if enabled (see `direct.h`), or with its
+/// `driver_*` function.
+#define DRIVE(routine, fn, nsamples, nreps, samples, ...)                                          \
+    do {                                                                                           \
+        direct_##routine##_fn_t* direct = (direct_##routine##_fn_t*)direct_driver(                 \
+            (void (*)(void))(fn)                                                                   \
+        );                                                                                         \
+        if (direct != NULL) {                                                                      \
+            direct(nsamples, nreps, samples, __VA_ARGS__);                                         \
+        } else {                                                                                   \
+            driver_##routine(nsamples, nreps, samples, fn, __VA_ARGS__);                           \
+        }                                                                                          \
+    } while (0)
+
+/// Runs a benchmark isolated, then again under the load of the co-runners (if any).
+#define RUN(bench)                                                                                 \
+    do {                                                                                           \
+        bench;                                                                                     \
+        if (corun_enabled()) {                                                                     \
+            corun_set_loaded(true);                                                                \
+            bench;                                                                                 \
+            corun_set_loaded(false);                                                               \
+        }                                                                                          \
+    } while (0)
+
+/// Runs a benchmark of a routine of `registry.h` with `RUN`, then again through the direct-call
+/// drivers at each unroll factor for the call overhead report (if enabled).
+#define RUN_DIRECT(bench)                                                                          \
+    do {                                                                                           \
+        RUN(bench);                                                                                \
+        if (direct_reporting()) {                                                                  \
+            static size_t const unrolls[DIRECT_NUNROLLS] = DIRECT_UNROLLS;                         \
+            for (size_t u = 0; u < DIRECT_NUNROLLS; ++u) {                                         \
+                direct_set_rerun(unrolls[u]);                                                      \
+                bench;                                                                             \
+            }                                                                                      \
+            direct_set_rerun(0);                                                                   \
+        }                                                                                          \
+    } while (0)
+
+/// Number of implementations registered in a static table.
+#define NIMPLS(impls) (sizeof(impls) / sizeof((impls)[0]))
+
+static inline size_t determine_warmup_reps(size_t bench_reps) {
     return bench_reps > 10 ? bench_reps / 10 : 1;
 }
 
+/// Prints the cost of vector-length agnostic code: for each fixed-VL kernel (`_vl<bits>` symbol
+/// suffix), the runtime of its VLA counterpart over the whole sweep, relative to its own.
+/// `total` holds the runtime of each implementation summed over the sweep.
+static void print_vla_cost(size_t nimpls, impl_t const impls[nimpls], double const total[nimpls]) {
+    // Runtimes are not measured when counting instructions
+    if (bench_counting()) {
+        return;
+    }
+    bool header = false;
+    for (size_t i = 0; i < nimpls; ++i) {
+        char const* suffix = strstr(impls[i].symbol, "_vl");
+        if (suffix == NULL) {
+            continue;
+        }
+        size_t const len = (size_t)(suffix - impls[i].symbol);
+        for (size_t j = 0; j < nimpls; ++j) {
+            if (strlen(impls[j].symbol) != len || strncmp(impls[j].symbol, impls[i].symbol, len)) {
+                continue;
+            }
+            if (!header) {
+                printf(
+                    "\n%30s |%30s |%12s\n",
+                    "FIXED-VL IMPLEMENTATION", "VLA IMPLEMENTATION", "VLA COST"
+                );
+                header = true;
+            }
+            double const cost = (total[j] - total[i]) / total[i] * 100.0;
+            printf("%30s |%30s |%+11.2lf%%\n", impls[i].name, impls[j].name, cost);
+        }
+    }
+}
+
 void bench_memcmp(size_t nbench, size_t const buf_sizes[nbench], size_t const bench_reps[nbench]) {
-    double samples_old[NSAMPLES] = { 0 };
-    double samples_new[NSAMPLES] = { 0 };
+    static impl_t const registry[] = {
+        MEMCMP_REGISTRY(IMPL_ENTRY)
+    };
+    impl_t impls[BENCH_MAX_IMPLS];
+    size_t const nimpls = bench_select(NIMPLS(registry), registry, impls);
+    double samples[BENCH_MAX_IMPLS][NSAMPLES] = { 0 };
+    sample_slot_t slots[BENCH_MAX_IMPLS * NSAMPLES];
+    double total[BENCH_MAX_IMPLS] = { 0 };
 
     for (size_t b = 0; b < nbench; ++b) {
         // Benchmark initialization
         benchmark_t memcmp_bench = {
-#ifdef CMP_LIBC
-            .name_old = "memcmp (GNU libc 2.39)",
-#else
-            .name_old = "memcmp (Arm OR 23.01)",
-#endif
-            .name_new = "memcmp (LI-PaRAD)",
+            .routine = "memcmp",
+            .impls = impls,
+            .nimpls = nimpls,
             .nsamples = NSAMPLES,
             .nreps = bench_reps[b],
             .buf_size = buf_sizes[b],
+            .traffic = TRAFFIC_READ2,
         };
 
         // Random memory initialization
@@ -79,54 +195,73 @@ void bench_memcmp(size_t nbench, size_t const buf_sizes[nbench], size_t const be
         init_buf_copy(buf_sizes[b], s2, s1); // Make data identical to avoid early function exit
 
 #ifdef DEBUG
-        fprintf(stderr, "Checking `new_memcmp_aarch64_sve`... ");
-        assert(
-            memcmp(s1, s2, buf_sizes[b]) == new_memcmp_aarch64_sve(s1, s2, buf_sizes[b]) &&
-            "`new_memcmp_aarch64_sve` failed"
-        );
-        fprintf(stderr, "OK\n");
+        for (size_t i = 0; i < nimpls; ++i) {
+            fprintf(stderr, "Checking `%s`... ", impls[i].name);
+            memcmp_fn_t* memcmp_fn = (memcmp_fn_t*)impls[i].fn;
+            assert(
+                memcmp(s1, s2, buf_sizes[b]) == memcmp_fn(s1, s2, buf_sizes[b]) &&
+                "`memcmp` implementation failed"
+            );
+            fprintf(stderr, "OK\n");
+        }
 #endif
 
-        // Warmup runs
-        size_t const warmup_cnt = determine_warmup_cnt(bench_reps[b]);
-        for (size_t i = 0; i < warmup_cnt; ++i) {
-            (void)memcmp(s1, s2, buf_sizes[b]);
+        // Warmup runs (each implementation until its runtime stabilizes)
+        size_t const warmup_reps = determine_warmup_reps(bench_reps[b]);
+        for (size_t i = 0; i < nimpls; ++i) {
+            memcmp_fn_t* memcmp_fn = (memcmp_fn_t*)impls[i].fn;
+            warmup_t w = bench_warmup_start();
+            double t;
+            do {
+                DRIVE(memcmp, memcmp_fn, 1, warmup_reps, &t, s1, s2, buf_sizes[b]);
+            } while (!bench_warmup_steady(&w, t));
+            memcmp_bench.warmup[i] = w;
         }
 
         // Run benchmark
-#ifdef CMP_LIBC
-        driver_memcmp(NSAMPLES, bench_reps[b], samples_old, memcmp, s1, s2, buf_sizes[b]);
-#else
-        driver_memcmp(NSAMPLES, bench_reps[b], samples_old, __memcmp_aarch64_sve, s1, s2, buf_sizes[b]);
-#endif
-        driver_memcmp(NSAMPLES, bench_reps[b], samples_new, new_memcmp_aarch64_sve, s1, s2, buf_sizes[b]);
+        size_t const nslots = bench_schedule(nimpls, NSAMPLES, slots);
+        for (size_t k = 0; k < nslots; ++k) {
+            size_t const i = slots[k].impl;
+            size_t const e = slots[k].sample;
+            memcmp_fn_t* memcmp_fn = (memcmp_fn_t*)impls[i].fn;
+            DRIVE(memcmp, memcmp_fn, 1, bench_reps[b], &samples[i][e], s1, s2, buf_sizes[b]);
+        }
 
         // Process and display results
-        bench_process(&memcmp_bench, NSAMPLES, samples_old, samples_new);
+        bench_process(&memcmp_bench, NSAMPLES, samples);
         bench_print(&memcmp_bench);
+        for (size_t i = 0; i < nimpls; ++i) {
+            total[i] += memcmp_bench.rt[i].avg;
+        }
+        dispatch_record("memcmp", &memcmp_bench);
 
         // Cleanup
         free(s1);
         free(s2);
     }
+    dispatch_check("memcmp");
+    print_vla_cost(nimpls, impls, total);
 }
 
 void bench_memcpy(size_t nbench, size_t const buf_sizes[nbench], size_t const bench_reps[nbench]) {
-    double samples_old[NSAMPLES] = { 0 };
-    double samples_new[NSAMPLES] = { 0 };
+    static impl_t const registry[] = {
+        MEMCPY_REGISTRY(IMPL_ENTRY)
+    };
+    impl_t impls[BENCH_MAX_IMPLS];
+    size_t const nimpls = bench_select(NIMPLS(registry), registry, impls);
+    double samples[BENCH_MAX_IMPLS][NSAMPLES] = { 0 };
+    sample_slot_t slots[BENCH_MAX_IMPLS * NSAMPLES];
 
     for (size_t b = 0; b < nbench; ++b) {
         // Benchmark initialization
         benchmark_t memcpy_bench = {
-#ifdef CMP_LIBC
-            .name_old = "memcpy (GNU libc 2.39)",
-#else
-            .name_old = "memcpy (Arm OR 23.01)",
-#endif
-            .name_new = "memcpy (LI-PaRAD)",
+            .routine = "memcpy",
+            .impls = impls,
+            .nimpls = nimpls,
             .nsamples = NSAMPLES,
             .nreps = bench_reps[b],
             .buf_size = buf_sizes[b],
+            .traffic = TRAFFIC_COPY,
         };
 
         // Random char initialization
@@ -135,52 +270,409 @@ void bench_memcpy(size_t nbench, size_t const buf_sizes[nbench], size_t const be
         init_buf_rand(buf_sizes[b], src, false);
 
 #ifdef DEBUG
-        fprintf(stderr, "Checking `new_memcpy_aarch64_sve`... ");
-        new_memcpy_aarch64_sve(dst, src, buf_sizes[b]);
-        assert(memcmp(src, dst, buf_sizes[b]) == 0 && "`new_memcpy_aarch64_sve` failed");
-        fprintf(stderr, "OK\n");
+        for (size_t i = 0; i < nimpls; ++i) {
+            fprintf(stderr, "Checking `%s`... ", impls[i].name);
+            memcpy_fn_t* memcpy_fn = (memcpy_fn_t*)impls[i].fn;
+            memset(dst, 0, buf_sizes[b] + 1);
+            memcpy_fn(dst, src, buf_sizes[b]);
+            assert(memcmp(src, dst, buf_sizes[b]) == 0 && "`memcpy` implementation failed");
+            fprintf(stderr, "OK\n");
+        }
 #endif
 
-        // Warmup runs
-        size_t const warmup_cnt = determine_warmup_cnt(bench_reps[b]);
-        for (size_t i = 0; i < warmup_cnt; ++i) {
-            (void)memcpy(dst, src, buf_sizes[b]);
+        // Warmup runs (each implementation until its runtime stabilizes)
+        size_t const warmup_reps = determine_warmup_reps(bench_reps[b]);
+        for (size_t i = 0; i < nimpls; ++i) {
+            memcpy_fn_t* memcpy_fn = (memcpy_fn_t*)impls[i].fn;
+            warmup_t w = bench_warmup_start();
+            double t;
+            do {
+                DRIVE(memcpy, memcpy_fn, 1, warmup_reps, &t, dst, src, buf_sizes[b]);
+            } while (!bench_warmup_steady(&w, t));
+            memcpy_bench.warmup[i] = w;
         }
 
         // Run benchmark
-#ifdef CMP_LIBC
-        driver_memcpy(NSAMPLES, bench_reps[b], samples_old, memcpy, dst, src, buf_sizes[b]);
-#else
-        driver_memcpy(NSAMPLES, bench_reps[b], samples_old, __memcpy_aarch64_sve, dst, src, buf_sizes[b]);
+        size_t const nslots = bench_schedule(nimpls, NSAMPLES, slots);
+        for (size_t k = 0; k < nslots; ++k) {
+            size_t const i = slots[k].impl;
+            size_t const e = slots[k].sample;
+            memcpy_fn_t* memcpy_fn = (memcpy_fn_t*)impls[i].fn;
+            DRIVE(memcpy, memcpy_fn, 1, bench_reps[b], &samples[i][e], dst, src, buf_sizes[b]);
+        }
+
+        // Process and display results
+        bench_process(&memcpy_bench, NSAMPLES, samples);
+        bench_print(&memcpy_bench);
+        dispatch_record("memcpy", &memcpy_bench);
+
+        // Cleanup
+        free(src);
+        free(dst);
+    }
+    dispatch_check("memcpy");
+}
+
+/// Parallel `memcpy` and `memcmp` on a fixed number of threads of the pool.
+#define PAR_FIXED(t)                                                                               \
+    static void* par_memcpy_t##t(void* restrict dst, void const* restrict src, size_t n) {         \
+        return par_memcpy_n(t, dst, src, n);                                                       \
+    }                                                                                              \
+    static int32_t par_memcmp_t##t(void const* s1, void const* s2, size_t n) {                     \
+        return par_memcmp_n(t, s1, s2, n);                                                         \
+    }
+PAR_FIXED(2)
+PAR_FIXED(4)
+PAR_FIXED(8)
+PAR_FIXED(16)
+PAR_FIXED(32)
+PAR_FIXED(64)
+
+/// Buffer sizes of the parallel benchmarks.
+static size_t const par_sizes[] = {
+    64ULL << 10, 256ULL << 10, 1ULL << 20, 4ULL << 20, 16ULL << 20, 64ULL << 20, 256ULL << 20,
+    512ULL << 20,
+};
+#define PAR_NSIZES (sizeof(par_sizes) / sizeof(par_sizes[0]))
+
+/// Number of threads of each parallel implementation (the single-thread kernel first, then
+/// `PAR_FIXED` ones, 0 for the choice by size).
+static size_t const par_threads[] = { 1, 2, 4, 8, 16, 32, 64, 0 };
+#define PAR_NIMPLS (sizeof(par_threads) / sizeof(par_threads[0]))
+
+/// Same as `bench_select`, skipping the implementations that need more threads than the pool has
+/// (they would run on fewer threads, measuring the same as another one).
+static size_t par_select(impl_t const registry[PAR_NIMPLS], impl_t impls[BENCH_MAX_IMPLS]) {
+    size_t const size = par_pool_size();
+    impl_t usable[PAR_NIMPLS];
+    size_t n = 0;
+    for (size_t i = 0; i < PAR_NIMPLS; ++i) {
+        if (par_threads[i] > size) {
+            fprintf(stderr, "Skipping `%s`: the pool has %zu threads\n", registry[i].name, size);
+            continue;
+        }
+        usable[n++] = registry[i];
+    }
+    return bench_select(n, usable, impls);
+}
+
+/// Number of repetitions of the parallel benchmarks (about 64 MiB per sample).
+static inline size_t par_reps(size_t n) {
+    return n < (64ULL << 20) ? (64ULL << 20) / n : 1;
+}
+
+/// Prints, for each parallel implementation, the smallest buffer size from which it beats the
+/// single-thread kernel (implementation 0) on every larger size.
+static void par_break_even(
+    size_t nimpls, impl_t const impls[nimpls], double rt[][BENCH_MAX_IMPLS]
+) {
+    printf("\n%30s |%16s\n", "ROUTINE IMPLEMENTATION", "BREAK-EVEN B");
+    for (size_t i = 1; i < nimpls; ++i) {
+        size_t b = PAR_NSIZES;
+        while (b > 0 && rt[b - 1][i] < rt[b - 1][0]) {
+            b -= 1;
+        }
+        if (b == PAR_NSIZES) {
+            printf("%30s |%16s\n", impls[i].name, "never");
+        } else {
+            printf("%30s |%16zu\n", impls[i].name, par_sizes[b]);
+        }
+    }
+}
+
+void bench_par_memcpy(void) {
+    static impl_t const registry[] = {
+        IMPL("memcpy (LI-PaRAD)", new_memcpy_aarch64_sve, CPU_FEAT_SVE),
+        IMPL("par_memcpy 2T (LI-PaRAD)", par_memcpy_t2, CPU_FEAT_SVE),
+        IMPL("par_memcpy 4T (LI-PaRAD)", par_memcpy_t4, CPU_FEAT_SVE),
+        IMPL("par_memcpy 8T (LI-PaRAD)", par_memcpy_t8, CPU_FEAT_SVE),
+        IMPL("par_memcpy 16T (LI-PaRAD)", par_memcpy_t16, CPU_FEAT_SVE),
+        IMPL("par_memcpy 32T (LI-PaRAD)", par_memcpy_t32, CPU_FEAT_SVE),
+        IMPL("par_memcpy 64T (LI-PaRAD)", par_memcpy_t64, CPU_FEAT_SVE),
+        IMPL("par_memcpy auto (LI-PaRAD)", par_memcpy, CPU_FEAT_SVE),
+    };
+    assert(NIMPLS(registry) == PAR_NIMPLS && "one thread count per implementation");
+    impl_t impls[BENCH_MAX_IMPLS];
+    size_t const nimpls = par_select(registry, impls);
+    double samples[BENCH_MAX_IMPLS][NSAMPLES] = { 0 };
+    sample_slot_t slots[BENCH_MAX_IMPLS * NSAMPLES];
+    double rt[PAR_NSIZES][BENCH_MAX_IMPLS] = { 0 };
+    printf("Thread pool: %zu threads\n", par_pool_size());
+    par_bind();
+
+    for (size_t b = 0; b < PAR_NSIZES; ++b) {
+        // Benchmark initialization
+        size_t const nreps = par_reps(par_sizes[b]);
+        benchmark_t memcpy_bench = {
+            .routine = "par_memcpy",
+            .impls = impls,
+            .nimpls = nimpls,
+            .nsamples = NSAMPLES,
+            .nreps = nreps,
+            .buf_size = par_sizes[b],
+            .traffic = TRAFFIC_COPY,
+        };
+
+        // Random char initialization
+        char* src = alloc(par_sizes[b] + 1);
+        char* dst = alloc(par_sizes[b] + 1);
+        init_buf_rand(par_sizes[b], src, false);
+
+#ifdef DEBUG
+        for (size_t i = 0; i < nimpls; ++i) {
+            fprintf(stderr, "Checking `%s`... ", impls[i].name);
+            memcpy_fn_t* memcpy_fn = (memcpy_fn_t*)impls[i].fn;
+            memset(dst, 0, par_sizes[b] + 1);
+            memcpy_fn(dst, src, par_sizes[b]);
+            assert(memcmp(src, dst, par_sizes[b]) == 0 && "`memcpy` implementation failed");
+            fprintf(stderr, "OK\n");
+        }
 #endif
-        driver_memcpy(NSAMPLES, bench_reps[b], samples_new, new_memcpy_aarch64_sve, dst, src, buf_sizes[b]);
+
+        // Warmup runs (each implementation until its runtime stabilizes)
+        size_t const warmup_reps = determine_warmup_reps(nreps);
+        for (size_t i = 0; i < nimpls; ++i) {
+            memcpy_fn_t* memcpy_fn = (memcpy_fn_t*)impls[i].fn;
+            warmup_t w = bench_warmup_start();
+            double t;
+            do {
+                driver_memcpy(1, warmup_reps, &t, memcpy_fn, dst, src, par_sizes[b]);
+            } while (!bench_warmup_steady(&w, t));
+            memcpy_bench.warmup[i] = w;
+        }
+
+        // Run benchmark
+        size_t const nslots = bench_schedule(nimpls, NSAMPLES, slots);
+        for (size_t k = 0; k < nslots; ++k) {
+            size_t const i = slots[k].impl;
+            size_t const e = slots[k].sample;
+            memcpy_fn_t* memcpy_fn = (memcpy_fn_t*)impls[i].fn;
+            driver_memcpy(1, nreps, &samples[i][e], memcpy_fn, dst, src, par_sizes[b]);
+        }
 
         // Process and display results
-        bench_process(&memcpy_bench, NSAMPLES, samples_old, samples_new);
+        bench_process(&memcpy_bench, NSAMPLES, samples);
         bench_print(&memcpy_bench);
+        for (size_t i = 0; i < nimpls; ++i) {
+            rt[b][i] = memcpy_bench.rt[i].avg;
+        }
+
+        // Cleanup
+        free(src);
+        free(dst);
+    }
+    par_unbind();
+    par_break_even(nimpls, impls, rt);
+}
+
+void bench_par_memcmp(void) {
+    static impl_t const registry[] = {
+        IMPL("memcmp (LI-PaRAD)", new_memcmp_aarch64_sve, CPU_FEAT_SVE),
+        IMPL("par_memcmp 2T (LI-PaRAD)", par_memcmp_t2, CPU_FEAT_SVE),
+        IMPL("par_memcmp 4T (LI-PaRAD)", par_memcmp_t4, CPU_FEAT_SVE),
+        IMPL("par_memcmp 8T (LI-PaRAD)", par_memcmp_t8, CPU_FEAT_SVE),
+        IMPL("par_memcmp 16T (LI-PaRAD)", par_memcmp_t16, CPU_FEAT_SVE),
+        IMPL("par_memcmp 32T (LI-PaRAD)", par_memcmp_t32, CPU_FEAT_SVE),
+        IMPL("par_memcmp 64T (LI-PaRAD)", par_memcmp_t64, CPU_FEAT_SVE),
+        IMPL("par_memcmp auto (LI-PaRAD)", par_memcmp, CPU_FEAT_SVE),
+    };
+    assert(NIMPLS(registry) == PAR_NIMPLS && "one thread count per implementation");
+    impl_t impls[BENCH_MAX_IMPLS];
+    size_t const nimpls = par_select(registry, impls);
+    double samples[BENCH_MAX_IMPLS][NSAMPLES] = { 0 };
+    sample_slot_t slots[BENCH_MAX_IMPLS * NSAMPLES];
+    double rt[PAR_NSIZES][BENCH_MAX_IMPLS] = { 0 };
+    printf("Thread pool: %zu threads\n", par_pool_size());
+    par_bind();
+
+    for (size_t b = 0; b < PAR_NSIZES; ++b) {
+        // Benchmark initialization
+        size_t const nreps = par_reps(par_sizes[b]);
+        benchmark_t memcmp_bench = {
+            .routine = "par_memcmp",
+            .impls = impls,
+            .nimpls = nimpls,
+            .nsamples = NSAMPLES,
+            .nreps = nreps,
+            .buf_size = par_sizes[b],
+            .traffic = TRAFFIC_READ2,
+        };
+
+        // Random char initialization (identical buffers: worst case)
+        char* s1 = alloc(par_sizes[b] + 1);
+        char* s2 = alloc(par_sizes[b] + 1);
+        init_buf_rand(par_sizes[b], s1, false);
+        memcpy(s2, s1, par_sizes[b]);
+
+#ifdef DEBUG
+        for (size_t i = 0; i < nimpls; ++i) {
+            fprintf(stderr, "Checking `%s`\n", impls[i].name);
+            memcmp_fn_t* memcmp_fn = (memcmp_fn_t*)impls[i].fn;
+            assert(memcmp_fn(s1, s2, par_sizes[b]) == 0 && "`memcmp` implementation failed");
+        }
+#endif
+
+        // Warmup runs (each implementation until its runtime stabilizes)
+        size_t const warmup_reps = determine_warmup_reps(nreps);
+        for (size_t i = 0; i < nimpls; ++i) {
+            memcmp_fn_t* memcmp_fn = (memcmp_fn_t*)impls[i].fn;
+            warmup_t w = bench_warmup_start();
+            double t;
+            do {
+                driver_memcmp(1, warmup_reps, &t, memcmp_fn, s1, s2, par_sizes[b]);
+            } while (!bench_warmup_steady(&w, t));
+            memcmp_bench.warmup[i] = w;
+        }
+
+        // Run benchmark
+        size_t const nslots = bench_schedule(nimpls, NSAMPLES, slots);
+        for (size_t k = 0; k < nslots; ++k) {
+            size_t const i = slots[k].impl;
+            size_t const e = slots[k].sample;
+            memcmp_fn_t* memcmp_fn = (memcmp_fn_t*)impls[i].fn;
+            driver_memcmp(1, nreps, &samples[i][e], memcmp_fn, s1, s2, par_sizes[b]);
+        }
+
+        // Process and display results
+        bench_process(&memcmp_bench, NSAMPLES, samples);
+        bench_print(&memcmp_bench);
+        for (size_t i = 0; i < nimpls; ++i) {
+            rt[b][i] = memcmp_bench.rt[i].avg;
+        }
+
+        // Cleanup
+        free(s1);
+        free(s2);
+    }
+    par_unbind();
+    par_break_even(nimpls, impls, rt);
+}
+
+/// Size of the working set re-read after each copy of the cache pollution benchmark (fits in L2).
+#define POLLUTION_VICTIM_SIZE (512ULL << 10)
+
+/// Measures the bandwidth of large copies and their cache pollution, i.e. the runtime of re-reading
+/// a hot working set after the copy (copy sizes span the last level cache of Neoverse CPUs).
+void bench_memcpy_pollution(void) {
+    static impl_t const registry[] = {
+#ifdef CMP_LIBC
+        IMPL("memcpy (GNU libc 2.39)", memcpy, CPU_FEAT_NONE),
+#else
+        IMPL("memcpy (Arm OR 23.01)", __memcpy_aarch64_sve, CPU_FEAT_SVE),
+#endif
+        IMPL("memcpy (LI-PaRAD)", new_memcpy_aarch64_sve, CPU_FEAT_SVE),
+        IMPL("memcpy x4 (LI-PaRAD)", new_memcpy_x4_aarch64_sve, CPU_FEAT_SVE),
+        IMPL("memcpy (AdvSIMD)", advsimd_memcpy_aarch64, CPU_FEAT_NONE),
+    };
+    static size_t const buf_sizes[] = { 4ULL << 20, 16ULL << 20, 64ULL << 20, 256ULL << 20 };
+    size_t const nbench = sizeof(buf_sizes) / sizeof(buf_sizes[0]);
+    impl_t impls[BENCH_MAX_IMPLS];
+    size_t const nimpls = bench_select(NIMPLS(registry), registry, impls);
+    double copy[BENCH_MAX_IMPLS][NSAMPLES] = { 0 };
+    double reread[BENCH_MAX_IMPLS][NSAMPLES] = { 0 };
+    sample_slot_t slots[BENCH_MAX_IMPLS * NSAMPLES];
+
+    uint64_t* victim = alloc(POLLUTION_VICTIM_SIZE);
+    init_buf_rand(POLLUTION_VICTIM_SIZE - 1, (char*)victim, false);
+
+    for (size_t b = 0; b < nbench; ++b) {
+        // Benchmark initialization (copy bandwidth, and victim re-read after the copy)
+        benchmark_t copy_bench = {
+            .routine = "memcpy_pollution",
+            .impls = impls,
+            .nimpls = nimpls,
+            .nsamples = NSAMPLES,
+            .nreps = 1,
+            .buf_size = buf_sizes[b],
+            .traffic = TRAFFIC_COPY,
+        };
+        benchmark_t reread_bench = {
+            .routine = "memcpy_pollution",
+            .impls = impls,
+            .nimpls = nimpls,
+            .nsamples = NSAMPLES,
+            .nreps = 1,
+            .buf_size = POLLUTION_VICTIM_SIZE,
+            .traffic = TRAFFIC_NONE,
+            .no_model = true,
+        };
+
+        // Random char initialization
+        char* src = alloc(buf_sizes[b] + 1);
+        char* dst = alloc(buf_sizes[b] + 1);
+        init_buf_rand(buf_sizes[b], src, false);
+
+#ifdef DEBUG
+        for (size_t i = 0; i < nimpls; ++i) {
+            fprintf(stderr, "Checking `%s`... ", impls[i].name);
+            memcpy_fn_t* memcpy_fn = (memcpy_fn_t*)impls[i].fn;
+            memset(dst, 0, buf_sizes[b] + 1);
+            memcpy_fn(dst, src, buf_sizes[b]);
+            assert(memcmp(src, dst, buf_sizes[b]) == 0 && "`memcpy` implementation failed");
+            fprintf(stderr, "OK\n");
+        }
+#endif
+
+        // Warmup runs (each implementation until its copy runtime stabilizes)
+        for (size_t i = 0; i < nimpls; ++i) {
+            memcpy_fn_t* memcpy_fn = (memcpy_fn_t*)impls[i].fn;
+            warmup_t w = bench_warmup_start();
+            double t, r;
+            do {
+                driver_memcpy_pollution(
+                    1, &t, &r, memcpy_fn, dst, src, buf_sizes[b], victim, POLLUTION_VICTIM_SIZE
+                );
+            } while (!bench_warmup_steady(&w, t));
+            copy_bench.warmup[i] = w;
+            reread_bench.warmup[i] = w;
+        }
+
+        // Run benchmark
+        size_t const nslots = bench_schedule(nimpls, NSAMPLES, slots);
+        for (size_t k = 0; k < nslots; ++k) {
+            size_t const i = slots[k].impl;
+            size_t const e = slots[k].sample;
+            memcpy_fn_t* memcpy_fn = (memcpy_fn_t*)impls[i].fn;
+            driver_memcpy_pollution(
+                1, &copy[i][e], &reread[i][e], memcpy_fn, dst, src, buf_sizes[b], victim,
+                POLLUTION_VICTIM_SIZE
+            );
+        }
+
+        // Process and display results (copy, then victim re-read)
+        bench_process(&copy_bench, NSAMPLES, copy);
+        bench_print(&copy_bench);
+        bench_process(&reread_bench, NSAMPLES, reread);
+        bench_print(&reread_bench);
 
         // Cleanup
         free(src);
         free(dst);
     }
+
+    free(victim);
 }
 
 void bench_strcmp(size_t nbench, size_t const buf_sizes[nbench], size_t const bench_reps[nbench]) {
-    double samples_old[NSAMPLES] = {0};
-    double samples_new[NSAMPLES] = {0};
+    static impl_t const registry[] = {
+        STRCMP_REGISTRY(IMPL_ENTRY)
+    };
+    impl_t impls[BENCH_MAX_IMPLS];
+    size_t const nimpls = bench_select(NIMPLS(registry), registry, impls);
+    double samples[BENCH_MAX_IMPLS][NSAMPLES] = { 0 };
+    sample_slot_t slots[BENCH_MAX_IMPLS * NSAMPLES];
+    double total[BENCH_MAX_IMPLS] = { 0 };
 
     for (size_t b = 0; b < nbench; ++b) {
         // Benchmark initialization
         benchmark_t strcmp_bench = {
-#ifdef CMP_LIBC
-            .name_old = "strcmp (GNU libc 2.39)",
-#else
-            .name_old = "strcmp (Arm OR 23.01)",
-#endif
-            .name_new = "strcmp (LI-PaRAD)",
+            .routine = "strcmp",
+            .impls = impls,
+            .nimpls = nimpls,
             .nsamples = NSAMPLES,
             .nreps = bench_reps[b],
             .buf_size = buf_sizes[b],
+            .traffic = TRAFFIC_READ2,
         };
 
         // Random ASCII initialization
@@ -190,53 +682,68 @@ void bench_strcmp(size_t nbench, size_t const buf_sizes[nbench], size_t const be
         init_buf_copy(buf_sizes[b], s2, s1);
 
 #ifdef DEBUG
-        fprintf(stderr, "Checking `new_strcmp_aarch64_sve`\n");
-        assert(
-            strcmp(s1, s2) == new_strcmp_aarch64_sve(s1, s2) &&
-            "`new_strcmp_aarch64_sve` failed"
-        );
+        for (size_t i = 0; i < nimpls; ++i) {
+            fprintf(stderr, "Checking `%s`\n", impls[i].name);
+            strcmp_fn_t* strcmp_fn = (strcmp_fn_t*)impls[i].fn;
+            assert(strcmp(s1, s2) == strcmp_fn(s1, s2) && "`strcmp` implementation failed");
+        }
 #endif
 
-        // Warmup runs
-        size_t const warmup_cnt = determine_warmup_cnt(bench_reps[b]);
-        for (size_t i = 0; i < warmup_cnt; ++i) {
-            (void)strcmp(s1, s2);
+        // Warmup runs (each implementation until its runtime stabilizes)
+        size_t const warmup_reps = determine_warmup_reps(bench_reps[b]);
+        for (size_t i = 0; i < nimpls; ++i) {
+            strcmp_fn_t* strcmp_fn = (strcmp_fn_t*)impls[i].fn;
+            warmup_t w = bench_warmup_start();
+            double t;
+            do {
+                DRIVE(strcmp, strcmp_fn, 1, warmup_reps, &t, s1, s2);
+            } while (!bench_warmup_steady(&w, t));
+            strcmp_bench.warmup[i] = w;
         }
 
         // Run benchmark
-#ifdef CMP_LIBC
-        driver_strcmp(NSAMPLES, bench_reps[b], samples_old, strcmp, s1, s2);
-#else
-        driver_strcmp(NSAMPLES, bench_reps[b], samples_old, __strcmp_aarch64_sve, s1, s2);
-#endif
-        driver_strcmp(NSAMPLES, bench_reps[b], samples_new, new_strcmp_aarch64_sve, s1, s2);
+        size_t const nslots = bench_schedule(nimpls, NSAMPLES, slots);
+        for (size_t k = 0; k < nslots; ++k) {
+            size_t const i = slots[k].impl;
+            size_t const e = slots[k].sample;
+            strcmp_fn_t* strcmp_fn = (strcmp_fn_t*)impls[i].fn;
+            DRIVE(strcmp, strcmp_fn, 1, bench_reps[b], &samples[i][e], s1, s2);
+        }
 
         // Process and display results
-        bench_process(&strcmp_bench, NSAMPLES, samples_old, samples_new);
+        bench_process(&strcmp_bench, NSAMPLES, samples);
         bench_print(&strcmp_bench);
+        for (size_t i = 0; i < nimpls; ++i) {
+            total[i] += strcmp_bench.rt[i].avg;
+        }
 
         // Cleanup
         free(s1);
         free(s2);
     }
+    print_vla_cost(nimpls, impls, total);
 }
 
 void bench_strncmp(size_t nbench, size_t const buf_sizes[nbench], size_t const bench_reps[nbench]) {
-    double samples_old[NSAMPLES] = {0};
-    double samples_new[NSAMPLES] = {0};
+    static impl_t const registry[] = {
+        STRNCMP_REGISTRY(IMPL_ENTRY)
+    };
+    impl_t impls[BENCH_MAX_IMPLS];
+    size_t const nimpls = bench_select(NIMPLS(registry), registry, impls);
+    double samples[BENCH_MAX_IMPLS][NSAMPLES] = { 0 };
+    sample_slot_t slots[BENCH_MAX_IMPLS * NSAMPLES];
+    double total[BENCH_MAX_IMPLS] = { 0 };
 
     for (size_t b = 0; b < nbench; ++b) {
         // Benchmark initialization
         benchmark_t strncmp_bench = {
-#ifdef CMP_LIBC
-            .name_old = "strncmp (GNU libc 2.39)",
-#else
-            .name_old = "strncmp (Arm OR 23.01)",
-#endif
-            .name_new = "strncmp (LI-PaRAD)",
+            .routine = "strncmp",
+            .impls = impls,
+            .nimpls = nimpls,
             .nsamples = NSAMPLES,
             .nreps = bench_reps[b],
             .buf_size = buf_sizes[b],
+            .traffic = TRAFFIC_READ2,
         };
 
         // Random ASCII initialization
@@ -246,30 +753,216 @@ void bench_strncmp(size_t nbench, size_t const buf_sizes[nbench], size_t const b
         init_buf_copy(buf_sizes[b], s2, s1);
 
 #ifdef DEBUG
-        fprintf(stderr, "Checking `new_strncmp_aarch64_sve`\n");
-        assert(
-            strncmp(s1, s2, buf_sizes[b]) == new_strncmp_aarch64_sve(s1, s2, buf_sizes[b]) &&
-            "`new_strncmp_aarch64_sve` failed"
-        );
+        for (size_t i = 0; i < nimpls; ++i) {
+            fprintf(stderr, "Checking `%s`\n", impls[i].name);
+            strncmp_fn_t* strncmp_fn = (strncmp_fn_t*)impls[i].fn;
+            assert(
+                strncmp(s1, s2, buf_sizes[b]) == strncmp_fn(s1, s2, buf_sizes[b]) &&
+                "`strncmp` implementation failed"
+            );
+        }
 #endif
 
-        // Warmup runs
-        size_t const warmup_cnt = determine_warmup_cnt(bench_reps[b]);
-        for (size_t i = 0; i < warmup_cnt; ++i) {
-            (void)strncmp(s1, s2, buf_sizes[b]);
+        // Warmup runs (each implementation until its runtime stabilizes)
+        size_t const warmup_reps = determine_warmup_reps(bench_reps[b]);
+        for (size_t i = 0; i < nimpls; ++i) {
+            strncmp_fn_t* strncmp_fn = (strncmp_fn_t*)impls[i].fn;
+            warmup_t w = bench_warmup_start();
+            double t;
+            do {
+                DRIVE(strncmp, strncmp_fn, 1, warmup_reps, &t, s1, s2, buf_sizes[b]);
+            } while (!bench_warmup_steady(&w, t));
+            strncmp_bench.warmup[i] = w;
         }
 
         // Run benchmark
-#ifdef CMP_LIBC
-        driver_strncmp(NSAMPLES, bench_reps[b], samples_old, strncmp, s1, s2, buf_sizes[b]);
-#else
-        driver_strncmp(NSAMPLES, bench_reps[b], samples_old, __strncmp_aarch64_sve, s1, s2, buf_sizes[b]);
-#endif
-        driver_strncmp(NSAMPLES, bench_reps[b], samples_new, new_strncmp_aarch64_sve, s1, s2, buf_sizes[b]);
+        size_t const nslots = bench_schedule(nimpls, NSAMPLES, slots);
+        for (size_t k = 0; k < nslots; ++k) {
+            size_t const i = slots[k].impl;
+            size_t const e = slots[k].sample;
+            strncmp_fn_t* strncmp_fn = (strncmp_fn_t*)impls[i].fn;
+            DRIVE(strncmp, strncmp_fn, 1, bench_reps[b], &samples[i][e], s1, s2, buf_sizes[b]);
+        }
 
         // Process and display results
-        bench_process(&strncmp_bench, NSAMPLES, samples_old, samples_new);
+        bench_process(&strncmp_bench, NSAMPLES, samples);
         bench_print(&strncmp_bench);
+        for (size_t i = 0; i < nimpls; ++i) {
+            total[i] += strncmp_bench.rt[i].avg;
+        }
+        dispatch_record("strncmp", &strncmp_bench);
+
+        // Cleanup
+        free(s1);
+        free(s2);
+    }
+    dispatch_check("strncmp");
+    print_vla_cost(nimpls, impls, total);
+}
+
+void bench_strcasecmp(size_t nbench, size_t const buf_sizes[nbench], size_t const bench_reps[nbench]) {
+    static impl_t const registry[] = {
+        IMPL("strcasecmp (GNU libc 2.39)", strcasecmp, CPU_FEAT_NONE),
+        IMPL("strcasecmp (LI-PaRAD)", new_strcasecmp_aarch64_sve, CPU_FEAT_SVE),
+        IMPL("strcasecmp (ACLE GCC)", acle_gcc_strcasecmp_aarch64_sve, CPU_FEAT_SVE),
+        IMPL("strcasecmp (ACLE Clang)", acle_clang_strcasecmp_aarch64_sve, CPU_FEAT_SVE),
+        IMPL("strcasecmp (AdvSIMD)", advsimd_strcasecmp_aarch64, CPU_FEAT_NONE),
+        IMPL("strcasecmp (C reference)", ref_strcasecmp, CPU_FEAT_NONE),
+    };
+    impl_t impls[BENCH_MAX_IMPLS];
+    size_t const nimpls = bench_select(NIMPLS(registry), registry, impls);
+    double samples[BENCH_MAX_IMPLS][NSAMPLES] = { 0 };
+    sample_slot_t slots[BENCH_MAX_IMPLS * NSAMPLES];
+
+    for (size_t b = 0; b < nbench; ++b) {
+        // Benchmark initialization
+        benchmark_t strcasecmp_bench = {
+            .routine = "strcasecmp",
+            .impls = impls,
+            .nimpls = nimpls,
+            .nsamples = NSAMPLES,
+            .nreps = bench_reps[b],
+            .buf_size = buf_sizes[b],
+            .traffic = TRAFFIC_READ2,
+        };
+
+        // Random ASCII initialization, with the case of letters swapped in the second string
+        char* s1 = alloc(buf_sizes[b] + 1);
+        char* s2 = alloc(buf_sizes[b] + 1);
+        init_buf_rand(buf_sizes[b], s1, true);
+        init_buf_swapcase(buf_sizes[b], s2, s1);
+
+#ifdef DEBUG
+        // All implementations only fold ASCII letters in the C locale
+        setlocale(LC_ALL, "C");
+        for (size_t i = 0; i < nimpls; ++i) {
+            fprintf(stderr, "Checking `%s`\n", impls[i].name);
+            strcasecmp_fn_t* strcasecmp_fn = (strcasecmp_fn_t*)impls[i].fn;
+            assert(
+                strcasecmp(s1, s2) == strcasecmp_fn(s1, s2) &&
+                "`strcasecmp` implementation failed"
+            );
+            s2[buf_sizes[b] - 1] = '~'; // Differ on the last character
+            assert(
+                strcasecmp(s1, s2) == strcasecmp_fn(s1, s2) &&
+                "`strcasecmp` implementation failed"
+            );
+            init_buf_swapcase(buf_sizes[b], s2, s1);
+        }
+#endif
+
+        // Warmup runs (each implementation until its runtime stabilizes)
+        size_t const warmup_reps = determine_warmup_reps(bench_reps[b]);
+        for (size_t i = 0; i < nimpls; ++i) {
+            strcasecmp_fn_t* strcasecmp_fn = (strcasecmp_fn_t*)impls[i].fn;
+            warmup_t w = bench_warmup_start();
+            double t;
+            do {
+                driver_strcasecmp(1, warmup_reps, &t, strcasecmp_fn, s1, s2);
+            } while (!bench_warmup_steady(&w, t));
+            strcasecmp_bench.warmup[i] = w;
+        }
+
+        // Run benchmark
+        size_t const nslots = bench_schedule(nimpls, NSAMPLES, slots);
+        for (size_t k = 0; k < nslots; ++k) {
+            size_t const i = slots[k].impl;
+            size_t const e = slots[k].sample;
+            strcasecmp_fn_t* strcasecmp_fn = (strcasecmp_fn_t*)impls[i].fn;
+            driver_strcasecmp(1, bench_reps[b], &samples[i][e], strcasecmp_fn, s1, s2);
+        }
+
+        // Process and display results
+        bench_process(&strcasecmp_bench, NSAMPLES, samples);
+        bench_print(&strcasecmp_bench);
+
+        // Cleanup
+        free(s1);
+        free(s2);
+    }
+}
+
+void bench_strncasecmp(size_t nbench, size_t const buf_sizes[nbench], size_t const bench_reps[nbench]) {
+    static impl_t const registry[] = {
+        IMPL("strncasecmp (GNU libc 2.39)", strncasecmp, CPU_FEAT_NONE),
+        IMPL("strncasecmp (LI-PaRAD)", new_strncasecmp_aarch64_sve, CPU_FEAT_SVE),
+        IMPL("strncasecmp (ACLE GCC)", acle_gcc_strncasecmp_aarch64_sve, CPU_FEAT_SVE),
+        IMPL("strncasecmp (ACLE Clang)", acle_clang_strncasecmp_aarch64_sve, CPU_FEAT_SVE),
+        IMPL("strncasecmp (AdvSIMD)", advsimd_strncasecmp_aarch64, CPU_FEAT_NONE),
+        IMPL("strncasecmp (C reference)", ref_strncasecmp, CPU_FEAT_NONE),
+    };
+    impl_t impls[BENCH_MAX_IMPLS];
+    size_t const nimpls = bench_select(NIMPLS(registry), registry, impls);
+    double samples[BENCH_MAX_IMPLS][NSAMPLES] = { 0 };
+    sample_slot_t slots[BENCH_MAX_IMPLS * NSAMPLES];
+
+    for (size_t b = 0; b < nbench; ++b) {
+        // Benchmark initialization
+        benchmark_t strncasecmp_bench = {
+            .routine = "strncasecmp",
+            .impls = impls,
+            .nimpls = nimpls,
+            .nsamples = NSAMPLES,
+            .nreps = bench_reps[b],
+            .buf_size = buf_sizes[b],
+            .traffic = TRAFFIC_READ2,
+        };
+
+        // Random ASCII initialization, with the case of letters swapped in the second string
+        char* s1 = alloc(buf_sizes[b] + 1);
+        char* s2 = alloc(buf_sizes[b] + 1);
+        init_buf_rand(buf_sizes[b], s1, true);
+        init_buf_swapcase(buf_sizes[b], s2, s1);
+
+#ifdef DEBUG
+        // All implementations only fold ASCII letters in the C locale
+        setlocale(LC_ALL, "C");
+        for (size_t i = 0; i < nimpls; ++i) {
+            fprintf(stderr, "Checking `%s`\n", impls[i].name);
+            strncasecmp_fn_t* strncasecmp_fn = (strncasecmp_fn_t*)impls[i].fn;
+            assert(
+                strncasecmp(s1, s2, buf_sizes[b]) == strncasecmp_fn(s1, s2, buf_sizes[b]) &&
+                "`strncasecmp` implementation failed"
+            );
+            s2[buf_sizes[b] - 1] = '~'; // Differ on the last character, then stop just before it
+            assert(
+                strncasecmp(s1, s2, buf_sizes[b]) == strncasecmp_fn(s1, s2, buf_sizes[b]) &&
+                "`strncasecmp` implementation failed"
+            );
+            assert(
+                strncasecmp_fn(s1, s2, buf_sizes[b] - 1) == 0 &&
+                "`strncasecmp` implementation failed"
+            );
+            init_buf_swapcase(buf_sizes[b], s2, s1);
+        }
+#endif
+
+        // Warmup runs (each implementation until its runtime stabilizes)
+        size_t const warmup_reps = determine_warmup_reps(bench_reps[b]);
+        for (size_t i = 0; i < nimpls; ++i) {
+            strncasecmp_fn_t* strncasecmp_fn = (strncasecmp_fn_t*)impls[i].fn;
+            warmup_t w = bench_warmup_start();
+            double t;
+            do {
+                driver_strncasecmp(1, warmup_reps, &t, strncasecmp_fn, s1, s2, buf_sizes[b]);
+            } while (!bench_warmup_steady(&w, t));
+            strncasecmp_bench.warmup[i] = w;
+        }
+
+        // Run benchmark
+        size_t const nslots = bench_schedule(nimpls, NSAMPLES, slots);
+        for (size_t k = 0; k < nslots; ++k) {
+            size_t const i = slots[k].impl;
+            size_t const e = slots[k].sample;
+            strncasecmp_fn_t* strncasecmp_fn = (strncasecmp_fn_t*)impls[i].fn;
+            driver_strncasecmp(
+                1, bench_reps[b], &samples[i][e], strncasecmp_fn, s1, s2, buf_sizes[b]
+            );
+        }
+
+        // Process and display results
+        bench_process(&strncasecmp_bench, NSAMPLES, samples);
+        bench_print(&strncasecmp_bench);
 
         // Cleanup
         free(s1);
@@ -278,18 +971,20 @@ void bench_strncmp(size_t nbench, size_t const buf_sizes[nbench], size_t const b
 }
 
 void bench_strchr(size_t nbench, size_t const buf_sizes[nbench], size_t const bench_reps[nbench]) {
-    double samples_old[NSAMPLES] = {0};
-    double samples_new[NSAMPLES] = {0};
+    static impl_t const registry[] = {
+        STRCHR_REGISTRY(IMPL_ENTRY)
+    };
+    impl_t impls[BENCH_MAX_IMPLS];
+    size_t const nimpls = bench_select(NIMPLS(registry), registry, impls);
+    double samples[BENCH_MAX_IMPLS][NSAMPLES] = { 0 };
+    sample_slot_t slots[BENCH_MAX_IMPLS * NSAMPLES];
 
     for (size_t b = 0; b < nbench; ++b) {
         // Benchmark initialization
         benchmark_t strchr_bench = {
-#ifdef CMP_LIBC
-            .name_old = "strchr (GNU libc 2.39)",
-#else
-            .name_old = "strchr (Arm OR 23.01)",
-#endif
-            .name_new = "strchr (LI-PaRAD)",
+            .routine = "strchr",
+            .impls = impls,
+            .nimpls = nimpls,
             .nsamples = NSAMPLES,
             .nreps = bench_reps[b],
             .buf_size = buf_sizes[b],
@@ -301,26 +996,36 @@ void bench_strchr(size_t nbench, size_t const buf_sizes[nbench], size_t const be
         int32_t c = 0; // Look for '\0'
 
 #ifdef DEBUG
-        fprintf(stderr, "Checking `new_strchr_aarch64_sve`\n");
-        assert(strchr(s, c) == new_strchr_aarch64_sve(s, c) && "`new_strchr_aarch64_sve` failed");
+        for (size_t i = 0; i < nimpls; ++i) {
+            fprintf(stderr, "Checking `%s`\n", impls[i].name);
+            strchr_fn_t* strchr_fn = (strchr_fn_t*)impls[i].fn;
+            assert(strchr(s, c) == strchr_fn(s, c) && "`strchr` implementation failed");
+        }
 #endif
 
-        // Warmup runs
-        size_t const warmup_cnt = determine_warmup_cnt(bench_reps[b]);
-        for (size_t i = 0; i < warmup_cnt; ++i) {
-            (void)strchr(s, c);
+        // Warmup runs (each implementation until its runtime stabilizes)
+        size_t const warmup_reps = determine_warmup_reps(bench_reps[b]);
+        for (size_t i = 0; i < nimpls; ++i) {
+            strchr_fn_t* strchr_fn = (strchr_fn_t*)impls[i].fn;
+            warmup_t w = bench_warmup_start();
+            double t;
+            do {
+                DRIVE(strchr, strchr_fn, 1, warmup_reps, &t, s, c);
+            } while (!bench_warmup_steady(&w, t));
+            strchr_bench.warmup[i] = w;
         }
 
-// Run benchmark
-#ifdef CMP_LIBC
-        driver_strchr(NSAMPLES, bench_reps[b], samples_old, strchr, s, c);
-#else
-        driver_strchr(NSAMPLES, bench_reps[b], samples_old, __strchr_aarch64_sve, s, c);
-#endif
-        driver_strchr(NSAMPLES, bench_reps[b], samples_new, new_strchr_aarch64_sve, s, c);
+        // Run benchmark
+        size_t const nslots = bench_schedule(nimpls, NSAMPLES, slots);
+        for (size_t k = 0; k < nslots; ++k) {
+            size_t const i = slots[k].impl;
+            size_t const e = slots[k].sample;
+            strchr_fn_t* strchr_fn = (strchr_fn_t*)impls[i].fn;
+            DRIVE(strchr, strchr_fn, 1, bench_reps[b], &samples[i][e], s, c);
+        }
 
         // Process and display results
-        bench_process(&strchr_bench, NSAMPLES, samples_old, samples_new);
+        bench_process(&strchr_bench, NSAMPLES, samples);
         bench_print(&strchr_bench);
 
         // Cleanup
@@ -329,18 +1034,20 @@ void bench_strchr(size_t nbench, size_t const buf_sizes[nbench], size_t const be
 }
 
 void bench_strrchr(size_t nbench, size_t const buf_sizes[nbench], size_t const bench_reps[nbench]) {
-    double samples_old[NSAMPLES] = {0};
-    double samples_new[NSAMPLES] = {0};
+    static impl_t const registry[] = {
+        STRRCHR_REGISTRY(IMPL_ENTRY)
+    };
+    impl_t impls[BENCH_MAX_IMPLS];
+    size_t const nimpls = bench_select(NIMPLS(registry), registry, impls);
+    double samples[BENCH_MAX_IMPLS][NSAMPLES] = { 0 };
+    sample_slot_t slots[BENCH_MAX_IMPLS * NSAMPLES];
 
     for (size_t b = 0; b < nbench; ++b) {
         // Benchmark initialization
         benchmark_t strrchr_bench = {
-#ifdef CMP_LIBC
-            .name_old = "strrchr (GNU libc 2.39)",
-#else
-            .name_old = "strrchr (Arm OR 23.01)",
-#endif
-            .name_new = "strrchr (LI-PaRAD)",
+            .routine = "strrchr",
+            .impls = impls,
+            .nimpls = nimpls,
             .nsamples = NSAMPLES,
             .nreps = bench_reps[b],
             .buf_size = buf_sizes[b],
@@ -352,29 +1059,36 @@ void bench_strrchr(size_t nbench, size_t const buf_sizes[nbench], size_t const b
         int32_t c = 0; // Look for '\0'
 
 #ifdef DEBUG
-        fprintf(stderr, "Checking `new_strrchr_aarch64_sve`\n");
-        assert(
-            strrchr(s, c) == new_strrchr_aarch64_sve(s, c) &&
-            "`new_strrchr_aarch64_sve` failed"
-        );
+        for (size_t i = 0; i < nimpls; ++i) {
+            fprintf(stderr, "Checking `%s`\n", impls[i].name);
+            strrchr_fn_t* strrchr_fn = (strrchr_fn_t*)impls[i].fn;
+            assert(strrchr(s, c) == strrchr_fn(s, c) && "`strrchr` implementation failed");
+        }
 #endif
 
-        // Warmup runs
-        size_t const warmup_cnt = determine_warmup_cnt(bench_reps[b]);
-        for (size_t i = 0; i < warmup_cnt; ++i) {
-            (void)strrchr(s, c);
+        // Warmup runs (each implementation until its runtime stabilizes)
+        size_t const warmup_reps = determine_warmup_reps(bench_reps[b]);
+        for (size_t i = 0; i < nimpls; ++i) {
+            strrchr_fn_t* strrchr_fn = (strrchr_fn_t*)impls[i].fn;
+            warmup_t w = bench_warmup_start();
+            double t;
+            do {
+                DRIVE(strrchr, strrchr_fn, 1, warmup_reps, &t, s, c);
+            } while (!bench_warmup_steady(&w, t));
+            strrchr_bench.warmup[i] = w;
         }
 
         // Run benchmark
-#ifdef CMP_LIBC
-        driver_strrchr(NSAMPLES, bench_reps[b], samples_old, strrchr, s, c);
-#else
-        driver_strrchr(NSAMPLES, bench_reps[b], samples_old, __strrchr_aarch64_sve, s, c);
-#endif
-        driver_strrchr(NSAMPLES, bench_reps[b], samples_new, new_strrchr_aarch64_sve, s, c);
+        size_t const nslots = bench_schedule(nimpls, NSAMPLES, slots);
+        for (size_t k = 0; k < nslots; ++k) {
+            size_t const i = slots[k].impl;
+            size_t const e = slots[k].sample;
+            strrchr_fn_t* strrchr_fn = (strrchr_fn_t*)impls[i].fn;
+            DRIVE(strrchr, strrchr_fn, 1, bench_reps[b], &samples[i][e], s, c);
+        }
 
         // Process and display results
-        bench_process(&strrchr_bench, NSAMPLES, samples_old, samples_new);
+        bench_process(&strrchr_bench, NSAMPLES, samples);
         bench_print(&strrchr_bench);
 
         // Cleanup
@@ -383,21 +1097,24 @@ void bench_strrchr(size_t nbench, size_t const buf_sizes[nbench], size_t const b
 }
 
 void bench_strcpy(size_t nbench, size_t const buf_sizes[nbench], size_t const bench_reps[nbench]) {
-    double samples_old[NSAMPLES] = {0};
-    double samples_new[NSAMPLES] = {0};
+    static impl_t const registry[] = {
+        STRCPY_REGISTRY(IMPL_ENTRY)
+    };
+    impl_t impls[BENCH_MAX_IMPLS];
+    size_t const nimpls = bench_select(NIMPLS(registry), registry, impls);
+    double samples[BENCH_MAX_IMPLS][NSAMPLES] = { 0 };
+    sample_slot_t slots[BENCH_MAX_IMPLS * NSAMPLES];
 
     for (size_t b = 0; b < nbench; ++b) {
         // Benchmark initialization
         benchmark_t strcpy_bench = {
-#ifdef CMP_LIBC
-            .name_old = "strcpy (GNU libc 2.39)",
-#else
-            .name_old = "strcpy (Arm OR 23.01)",
-#endif
-            .name_new = "strcpy (LI-PaRAD)",
+            .routine = "strcpy",
+            .impls = impls,
+            .nimpls = nimpls,
             .nsamples = NSAMPLES,
             .nreps = bench_reps[b],
             .buf_size = buf_sizes[b],
+            .traffic = TRAFFIC_COPY,
         };
 
         // Random ASCII initialization
@@ -406,27 +1123,38 @@ void bench_strcpy(size_t nbench, size_t const buf_sizes[nbench], size_t const be
         init_buf_rand(buf_sizes[b], src, true);
 
 #ifdef DEBUG
-        fprintf(stderr, "Checking `new_strcpy_aarch64_sve`\n");
-        new_strcpy_aarch64_sve(dst, src);
-        assert(strcmp(src, dst) == 0 && "`new_strcpy_aarch64_sve` failed");
+        for (size_t i = 0; i < nimpls; ++i) {
+            fprintf(stderr, "Checking `%s`\n", impls[i].name);
+            strcpy_fn_t* strcpy_fn = (strcpy_fn_t*)impls[i].fn;
+            memset(dst, 0xff, buf_sizes[b] + 1);
+            strcpy_fn(dst, src);
+            assert(strcmp(src, dst) == 0 && "`strcpy` implementation failed");
+        }
 #endif
 
-        // Warmup runs
-        size_t const warmup_cnt = determine_warmup_cnt(bench_reps[b]);
-        for (size_t i = 0; i < warmup_cnt; ++i) {
-            (void)strcpy(dst, src);
+        // Warmup runs (each implementation until its runtime stabilizes)
+        size_t const warmup_reps = determine_warmup_reps(bench_reps[b]);
+        for (size_t i = 0; i < nimpls; ++i) {
+            strcpy_fn_t* strcpy_fn = (strcpy_fn_t*)impls[i].fn;
+            warmup_t w = bench_warmup_start();
+            double t;
+            do {
+                DRIVE(strcpy, strcpy_fn, 1, warmup_reps, &t, dst, src);
+            } while (!bench_warmup_steady(&w, t));
+            strcpy_bench.warmup[i] = w;
         }
 
         // Run benchmark
-#ifdef CMP_LIBC
-        driver_strcpy(NSAMPLES, bench_reps[b], samples_old, strcpy, dst, src);
-#else
-        driver_strcpy(NSAMPLES, bench_reps[b], samples_old, __strcpy_aarch64_sve, dst, src);
-#endif
-        driver_strcpy(NSAMPLES, bench_reps[b], samples_new, new_strcpy_aarch64_sve, dst, src);
+        size_t const nslots = bench_schedule(nimpls, NSAMPLES, slots);
+        for (size_t k = 0; k < nslots; ++k) {
+            size_t const i = slots[k].impl;
+            size_t const e = slots[k].sample;
+            strcpy_fn_t* strcpy_fn = (strcpy_fn_t*)impls[i].fn;
+            DRIVE(strcpy, strcpy_fn, 1, bench_reps[b], &samples[i][e], dst, src);
+        }
 
         // Process and display results
-        bench_process(&strcpy_bench, NSAMPLES, samples_old, samples_new);
+        bench_process(&strcpy_bench, NSAMPLES, samples);
         bench_print(&strcpy_bench);
 
         // Cleanup
@@ -436,17 +1164,24 @@ void bench_strcpy(size_t nbench, size_t const buf_sizes[nbench], size_t const be
 }
 
 void bench_strncpy(size_t nbench, size_t const buf_sizes[nbench], size_t const bench_reps[nbench]) {
-    double samples_old[NSAMPLES] = {0};
-    double samples_new[NSAMPLES] = {0};
+    static impl_t const registry[] = {
+        STRNCPY_REGISTRY(IMPL_ENTRY)
+    };
+    impl_t impls[BENCH_MAX_IMPLS];
+    size_t const nimpls = bench_select(NIMPLS(registry), registry, impls);
+    double samples[BENCH_MAX_IMPLS][NSAMPLES] = { 0 };
+    sample_slot_t slots[BENCH_MAX_IMPLS * NSAMPLES];
 
     for (size_t b = 0; b < nbench; ++b) {
         // Benchmark initialization
         benchmark_t strncpy_bench = {
-            .name_old = "strncpy (GNU libc 2.39)",
-            .name_new = "strncpy (LI-PaRAD)",
+            .routine = "strncpy",
+            .impls = impls,
+            .nimpls = nimpls,
             .nsamples = NSAMPLES,
             .nreps = bench_reps[b],
             .buf_size = buf_sizes[b],
+            .traffic = TRAFFIC_COPY,
         };
 
         // Random ASCII initialization
@@ -455,44 +1190,64 @@ void bench_strncpy(size_t nbench, size_t const buf_sizes[nbench], size_t const b
         init_buf_rand(buf_sizes[b], src, true);
 
 #ifdef DEBUG
-        fprintf(stderr, "Checking `new_strncpy_aarch64_sve`\n");
-        new_strncpy_aarch64_sve(dst, src, buf_sizes[b]);
-        assert(strncmp(src, dst, buf_sizes[b]) == 0 && "`new_strncpy_aarch64_sve` failed");
+        for (size_t i = 0; i < nimpls; ++i) {
+            fprintf(stderr, "Checking `%s`\n", impls[i].name);
+            strncpy_fn_t* strncpy_fn = (strncpy_fn_t*)impls[i].fn;
+            strncpy_fn(dst, src, buf_sizes[b]);
+            assert(strncmp(src, dst, buf_sizes[b]) == 0 && "`strncpy` implementation failed");
+        }
 #endif
 
-        // Warmup runs
-        size_t const warmup_cnt = determine_warmup_cnt(bench_reps[b]);
-        for (size_t i = 0; i < warmup_cnt; ++i) {
-            (void)strncpy(dst, src, buf_sizes[b]);
+        // Warmup runs (each implementation until its runtime stabilizes)
+        size_t const warmup_reps = determine_warmup_reps(bench_reps[b]);
+        for (size_t i = 0; i < nimpls; ++i) {
+            strncpy_fn_t* strncpy_fn = (strncpy_fn_t*)impls[i].fn;
+            warmup_t w = bench_warmup_start();
+            double t;
+            do {
+                DRIVE(strncpy, strncpy_fn, 1, warmup_reps, &t, dst, src, buf_sizes[b]);
+            } while (!bench_warmup_steady(&w, t));
+            strncpy_bench.warmup[i] = w;
         }
 
         // Run benchmark
-        driver_strncpy(NSAMPLES, bench_reps[b], samples_old, strncpy, dst, src, buf_sizes[b]);
-        driver_strncpy(NSAMPLES, bench_reps[b], samples_new, new_strncpy_aarch64_sve, dst, src, buf_sizes[b]);
+        size_t const nslots = bench_schedule(nimpls, NSAMPLES, slots);
+        for (size_t k = 0; k < nslots; ++k) {
+            size_t const i = slots[k].impl;
+            size_t const e = slots[k].sample;
+            strncpy_fn_t* strncpy_fn = (strncpy_fn_t*)impls[i].fn;
+            DRIVE(strncpy, strncpy_fn, 1, bench_reps[b], &samples[i][e], dst, src, buf_sizes[b]);
+        }
 
         // Process and display results
-        bench_process(&strncpy_bench, NSAMPLES, samples_old, samples_new);
+        bench_process(&strncpy_bench, NSAMPLES, samples);
         bench_print(&strncpy_bench);
+        dispatch_record("strncpy", &strncpy_bench);
 
         // Cleanup
         free(src);
         free(dst);
     }
+    dispatch_check("strncpy");
 }
 
-void bench_strlen(size_t nbench, size_t const buf_sizes[nbench], size_t const bench_reps[nbench]) {
-    double samples_old[NSAMPLES] = {0};
-    double samples_new[NSAMPLES] = {0};
+/// Benchmarks the selected `strlen` implementations on every buffer size.
+/// If `rt` is not `NULL`, the average runtime of implementation `i` on size `b` is written to
+/// `rt[b][i]`.
+static void run_strlen(
+    size_t nimpls, impl_t const impls[nimpls],
+    size_t nbench, size_t const buf_sizes[nbench], size_t const bench_reps[nbench],
+    double rt[][BENCH_MAX_IMPLS]
+) {
+    double samples[BENCH_MAX_IMPLS][NSAMPLES] = { 0 };
+    sample_slot_t slots[BENCH_MAX_IMPLS * NSAMPLES];
 
     for (size_t b = 0; b < nbench; ++b) {
         // Benchmark initialization
         benchmark_t strlen_bench = {
-#ifdef CMP_LIBC
-            .name_old = "strlen (GNU libc 2.39)",
-#else
-            .name_old = "strlen (Arm OR 23.01)",
-#endif
-            .name_new = "strlen (LI-PaRAD)",
+            .routine = "strlen",
+            .impls = impls,
+            .nimpls = nimpls,
             .nsamples = NSAMPLES,
             .nreps = bench_reps[b],
             .buf_size = buf_sizes[b],
@@ -503,46 +1258,188 @@ void bench_strlen(size_t nbench, size_t const buf_sizes[nbench], size_t const be
         init_buf_rand(buf_sizes[b], s, true);
 
 #ifdef DEBUG
-        fprintf(stderr, "Checking `new_strlen_aarch64_sve`\n");
-        assert(new_strlen_aarch64_sve(s) == buf_sizes[b] && "`new_strlen_aarch64_sve` failed");
+        for (size_t i = 0; i < nimpls; ++i) {
+            fprintf(stderr, "Checking `%s`\n", impls[i].name);
+            strlen_fn_t* strlen_fn = (strlen_fn_t*)impls[i].fn;
+            assert(strlen_fn(s) == buf_sizes[b] && "`strlen` implementation failed");
+        }
 #endif
 
-        // Warmup runs
-        size_t const warmup_cnt = determine_warmup_cnt(bench_reps[b]);
-        for (size_t i = 0; i < warmup_cnt; ++i) {
-            (void)strlen(s);
+        // Warmup runs (each implementation until its runtime stabilizes)
+        size_t const warmup_reps = determine_warmup_reps(bench_reps[b]);
+        for (size_t i = 0; i < nimpls; ++i) {
+            strlen_fn_t* strlen_fn = (strlen_fn_t*)impls[i].fn;
+            warmup_t w = bench_warmup_start();
+            double t;
+            do {
+                DRIVE(strlen, strlen_fn, 1, warmup_reps, &t, s);
+            } while (!bench_warmup_steady(&w, t));
+            strlen_bench.warmup[i] = w;
         }
 
         // Run benchmark
-#ifdef CMP_LIBC
-        driver_strlen(NSAMPLES, bench_reps[b], samples_old, strlen, s);
-#else
-        driver_strlen(NSAMPLES, bench_reps[b], samples_old, __strlen_aarch64_sve, s);
-#endif
-        driver_strlen(NSAMPLES, bench_reps[b], samples_new, new_strlen_aarch64_sve, s);
+        size_t const nslots = bench_schedule(nimpls, NSAMPLES, slots);
+        for (size_t k = 0; k < nslots; ++k) {
+            size_t const i = slots[k].impl;
+            size_t const e = slots[k].sample;
+            strlen_fn_t* strlen_fn = (strlen_fn_t*)impls[i].fn;
+            DRIVE(strlen, strlen_fn, 1, bench_reps[b], &samples[i][e], s);
+        }
 
         // Process and display results
-        bench_process(&strlen_bench, NSAMPLES, samples_old, samples_new);
+        bench_process(&strlen_bench, NSAMPLES, samples);
         bench_print(&strlen_bench);
+        if (rt != NULL) {
+            for (size_t i = 0; i < nimpls; ++i) {
+                rt[b][i] = strlen_bench.rt[i].avg;
+            }
+        }
 
         // Cleanup
         free(s);
     }
 }
 
+void bench_strlen(size_t nbench, size_t const buf_sizes[nbench], size_t const bench_reps[nbench]) {
+    static impl_t const registry[] = {
+        STRLEN_REGISTRY(IMPL_ENTRY)
+    };
+    impl_t impls[BENCH_MAX_IMPLS];
+    size_t const nimpls = bench_select(NIMPLS(registry), registry, impls);
+    double (*rt)[BENCH_MAX_IMPLS] = malloc(nbench * sizeof(*rt));
+    if (rt == NULL) {
+        fprintf(stderr, "Failed to allocate `strlen` results\n");
+        exit(1);
+    }
+    run_strlen(nimpls, impls, nbench, buf_sizes, bench_reps, rt);
+
+    double total[BENCH_MAX_IMPLS] = { 0 };
+    for (size_t b = 0; b < nbench; ++b) {
+        for (size_t i = 0; i < nimpls; ++i) {
+            total[i] += rt[b][i];
+        }
+    }
+    print_vla_cost(nimpls, impls, total);
+    free(rt);
+}
+
+/// Size class of a buffer size: the smallest power of two greater or equal to it.
+static inline size_t size_class(size_t size) {
+    size_t c = 1;
+    while (c < size) {
+        c <<= 1;
+    }
+    return c;
+}
+
+#ifdef DEBUG
+/// Checks a `strlen` implementation on strings that end right before an unmapped page.
+static void check_page_boundary(strlen_fn_t* strlen_fn, char const* name) {
+    size_t const page = (size_t)sysconf(_SC_PAGESIZE);
+    char* p = mmap(NULL, 2 * page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    assert(p != MAP_FAILED && "failed to map guard pages");
+    assert(mprotect(p + page, page, PROT_NONE) == 0 && "failed to protect guard page");
+
+    fprintf(stderr, "Checking `%s` at a page boundary\n", name);
+    memset(p, 'a', page);
+    for (size_t len = 0; len < page && len <= 1024; ++len) {
+        char* s = p + page - len - 1;
+        s[len] = '\0';
+        assert(strlen_fn(s) == len && "`strlen` implementation failed at a page boundary");
+        s[len] = 'a';
+    }
+    munmap(p, 2 * page);
+}
+#endif
+
+/// Benchmarks every generated kernel variant (see `variants.h`) and writes the fastest one of each
+/// size class to `path`, as CSV.
+void tune(
+    size_t nbench, size_t const buf_sizes[nbench], size_t const bench_reps[nbench], char const* path
+) {
+    static impl_t const registry[] = {
+#define X(symbol, name, faultsafe) IMPL(name, symbol, CPU_FEAT_SVE),
+        STRLEN_VARIANTS(X)
+#undef X
+    };
+#ifdef DEBUG
+    static bool const faultsafe[] = {
+#define X(symbol, name, faultsafe) faultsafe,
+        STRLEN_VARIANTS(X)
+#undef X
+    };
+#endif
+    impl_t impls[BENCH_MAX_IMPLS];
+    size_t const nimpls = bench_select(NIMPLS(registry), registry, impls);
+    if (nimpls == 0 || bench_counting()) {
+        fprintf(stderr, "Autotuning requires timing SVE kernel variants\n");
+        exit(1);
+    }
+
+#ifdef DEBUG
+    for (size_t i = 0; i < NIMPLS(registry); ++i) {
+        if (faultsafe[i]) {
+            check_page_boundary((strlen_fn_t*)registry[i].fn, registry[i].name);
+        }
+    }
+#endif
+
+    FILE* out = fopen(path, "w");
+    if (out == NULL) {
+        fprintf(stderr, "Failed to open `%s`\n", path);
+        exit(1);
+    }
+
+    double (*rt)[BENCH_MAX_IMPLS] = malloc(nbench * sizeof(*rt));
+    if (rt == NULL) {
+        fprintf(stderr, "Failed to allocate autotuning results\n");
+        exit(1);
+    }
+    run_strlen(nimpls, impls, nbench, buf_sizes, bench_reps, rt);
+
+    // Select the variant with the lowest average runtime over the sizes of each class
+    fprintf(out, "ROUTINE,MAX SIZE B,VARIANT,RT AVG ns\n");
+    printf("\n%12s |%-40s |%12s\n", "MAX SIZE B", "VARIANT", "RT AVG ns");
+    for (size_t b = 0; b < nbench;) {
+        size_t const c = size_class(buf_sizes[b]);
+        double sum[BENCH_MAX_IMPLS] = { 0 };
+        size_t n = 0;
+        for (; b < nbench && size_class(buf_sizes[b]) == c; ++b, ++n) {
+            for (size_t i = 0; i < nimpls; ++i) {
+                sum[i] += rt[b][i];
+            }
+        }
+
+        size_t best = 0;
+        for (size_t i = 1; i < nimpls; ++i) {
+            if (sum[i] < sum[best]) {
+                best = i;
+            }
+        }
+        fprintf(out, "strlen,%zu,%s,%.3lf\n", c, impls[best].symbol, sum[best] / (double)n);
+        printf("%12zu |%-40s |%12.3lf\n", c, impls[best].symbol, sum[best] / (double)n);
+    }
+
+    free(rt);
+    fclose(out);
+}
+
 void bench_strnlen(size_t nbench, size_t const buf_sizes[nbench], size_t const bench_reps[nbench]) {
-    double samples_old[NSAMPLES] = {0};
-    double samples_new[NSAMPLES] = {0};
+    static impl_t const registry[] = {
+        STRNLEN_REGISTRY(IMPL_ENTRY)
+    };
+    impl_t impls[BENCH_MAX_IMPLS];
+    size_t const nimpls = bench_select(NIMPLS(registry), registry, impls);
+    double samples[BENCH_MAX_IMPLS][NSAMPLES] = { 0 };
+    sample_slot_t slots[BENCH_MAX_IMPLS * NSAMPLES];
+    double total[BENCH_MAX_IMPLS] = { 0 };
 
     for (size_t b = 0; b < nbench; ++b) {
         // Benchmark initialization
         benchmark_t strnlen_bench = {
-#ifdef CMP_LIBC
-            .name_old = "strnlen (GNU libc 2.39)",
-#else
-            .name_old = "strnlen (Arm OR 23.01)",
-#endif
-            .name_new = "strnlen (LI-PaRAD)",
+            .routine = "strnlen",
+            .impls = impls,
+            .nimpls = nimpls,
             .nsamples = NSAMPLES,
             .nreps = bench_reps[b],
             .buf_size = buf_sizes[b],
@@ -553,33 +1450,693 @@ void bench_strnlen(size_t nbench, size_t const buf_sizes[nbench], size_t const b
         init_buf_rand(buf_sizes[b], s, true);
 
 #ifdef DEBUG
-        fprintf(stderr, "Checking `new_strnlen_aarch64_sve`\n");
-        assert(
-            new_strnlen_aarch64_sve(s, buf_sizes[b] * 2) == buf_sizes[b] &&
-            "`new_strnlen_aarch64_sve` failed"
-        );
+        for (size_t i = 0; i < nimpls; ++i) {
+            fprintf(stderr, "Checking `%s`\n", impls[i].name);
+            strnlen_fn_t* strnlen_fn = (strnlen_fn_t*)impls[i].fn;
+            assert(
+                strnlen_fn(s, buf_sizes[b] * 2) == buf_sizes[b] &&
+                "`strnlen` implementation failed"
+            );
+        }
 #endif
 
-        // Warmup runs
-        size_t const warmup_cnt = determine_warmup_cnt(bench_reps[b]);
-        for (size_t i = 0; i < warmup_cnt; ++i) {
-            (void)strnlen(s, buf_sizes[b]);
+        // Warmup runs (each implementation until its runtime stabilizes)
+        size_t const warmup_reps = determine_warmup_reps(bench_reps[b]);
+        for (size_t i = 0; i < nimpls; ++i) {
+            strnlen_fn_t* strnlen_fn = (strnlen_fn_t*)impls[i].fn;
+            warmup_t w = bench_warmup_start();
+            double t;
+            do {
+                DRIVE(strnlen, strnlen_fn, 1, warmup_reps, &t, s, buf_sizes[b]);
+            } while (!bench_warmup_steady(&w, t));
+            strnlen_bench.warmup[i] = w;
         }
 
         // Run benchmark
+        size_t const nslots = bench_schedule(nimpls, NSAMPLES, slots);
+        for (size_t k = 0; k < nslots; ++k) {
+            size_t const i = slots[k].impl;
+            size_t const e = slots[k].sample;
+            strnlen_fn_t* strnlen_fn = (strnlen_fn_t*)impls[i].fn;
+            DRIVE(strnlen, strnlen_fn, 1, bench_reps[b], &samples[i][e], s, buf_sizes[b]);
+        }
+
+        // Process and display results
+        bench_process(&strnlen_bench, NSAMPLES, samples);
+        bench_print(&strnlen_bench);
+        for (size_t i = 0; i < nimpls; ++i) {
+            total[i] += strnlen_bench.rt[i].avg;
+        }
+        dispatch_record("strnlen", &strnlen_bench);
+
+        // Cleanup
+        free(s);
+    }
+    dispatch_check("strnlen");
+    print_vla_cost(nimpls, impls, total);
+}
+
+/// Number of strings processed per call in the batched benchmarks.
+#define BATCH_NSTRINGS 64ULL
+
+/// Defines a batched wrapper that calls the single-string `strlen` implementation `fn` in a loop.
+#define STRLEN_LOOP(fn)                                                                            \
+    static void fn##_loop(char const* const* ptrs, size_t n, size_t* out) {                        \
+        for (size_t i = 0; i < n; ++i) {                                                           \
+            out[i] = fn(ptrs[i]);                                                                  \
+        }                                                                                          \
+    }
+
+/// Defines a batched wrapper that calls the single-string `strcmp` implementation `fn` in a loop.
+#define STRCMP_LOOP(fn)                                                                            \
+    static void fn##_loop(char const* const* s1, char const* const* s2, size_t n, int32_t* out) {  \
+        for (size_t i = 0; i < n; ++i) {                                                           \
+            out[i] = fn(s1[i], s2[i]);                                                             \
+        }                                                                                          \
+    }
+
 #ifdef CMP_LIBC
-        driver_strnlen(NSAMPLES, bench_reps[b], samples_old, strnlen, s, buf_sizes[b]);
+STRLEN_LOOP(strlen)
+STRCMP_LOOP(strcmp)
 #else
-        driver_strnlen(NSAMPLES, bench_reps[b], samples_old, __strnlen_aarch64_sve, s, buf_sizes[b]);
+STRLEN_LOOP(__strlen_aarch64_sve)
+STRCMP_LOOP(__strcmp_aarch64_sve)
+#endif
+STRLEN_LOOP(new_strlen_aarch64_sve)
+STRLEN_LOOP(advsimd_strlen_aarch64)
+STRCMP_LOOP(new_strcmp_aarch64_sve)
+STRCMP_LOOP(advsimd_strcmp_aarch64)
+
+/// Divides the per-call samples of a batched benchmark to get per-string samples.
+static inline void per_string_samples(size_t nimpls, size_t nsamples, double samples[][nsamples]) {
+    for (size_t i = 0; i < nimpls; ++i) {
+        for (size_t e = 0; e < nsamples; ++e) {
+            samples[i][e] /= (double)BATCH_NSTRINGS;
+        }
+    }
+}
+
+void bench_strlen_batch(size_t nbench, size_t const buf_sizes[nbench], size_t const bench_reps[nbench]) {
+    static impl_t const registry[] = {
+#ifdef CMP_LIBC
+        IMPL("strlen loop (GNU libc 2.39)", strlen_loop, CPU_FEAT_NONE),
+#else
+        IMPL("strlen loop (Arm OR 23.01)", __strlen_aarch64_sve_loop, CPU_FEAT_SVE),
+#endif
+        IMPL("strlen loop (LI-PaRAD)", new_strlen_aarch64_sve_loop, CPU_FEAT_SVE),
+        IMPL("strlen_batch (LI-PaRAD)", new_strlen_batch_aarch64_sve, CPU_FEAT_SVE),
+        IMPL("strlen loop (AdvSIMD)", advsimd_strlen_aarch64_loop, CPU_FEAT_NONE),
+    };
+    impl_t impls[BENCH_MAX_IMPLS];
+    size_t const nimpls = bench_select(NIMPLS(registry), registry, impls);
+    double samples[BENCH_MAX_IMPLS][NSAMPLES] = { 0 };
+    sample_slot_t slots[BENCH_MAX_IMPLS * NSAMPLES];
+
+    for (size_t b = 0; b < nbench; ++b) {
+        // Benchmark initialization (runtimes are reported per string)
+        size_t const nreps = bench_reps[b] > BATCH_NSTRINGS ? bench_reps[b] / BATCH_NSTRINGS : 1;
+        benchmark_t strlen_bench = {
+            .routine = "strlen_batch",
+            .impls = impls,
+            .nimpls = nimpls,
+            .nsamples = NSAMPLES,
+            .nreps = nreps,
+            .buf_size = buf_sizes[b],
+        };
+
+        // Random ASCII initialization
+        char* buf = alloc(BATCH_NSTRINGS * (buf_sizes[b] + 1));
+        char const* ptrs[BATCH_NSTRINGS];
+        size_t out[BATCH_NSTRINGS];
+        for (size_t j = 0; j < BATCH_NSTRINGS; ++j) {
+            char* s = buf + j * (buf_sizes[b] + 1);
+            init_buf_rand(buf_sizes[b], s, true);
+            ptrs[j] = s;
+        }
+
+#ifdef DEBUG
+        for (size_t i = 0; i < nimpls; ++i) {
+            fprintf(stderr, "Checking `%s`\n", impls[i].name);
+            strlen_batch_fn_t* strlen_batch_fn = (strlen_batch_fn_t*)impls[i].fn;
+            memset(out, 0, sizeof(out));
+            strlen_batch_fn(ptrs, BATCH_NSTRINGS, out);
+            for (size_t j = 0; j < BATCH_NSTRINGS; ++j) {
+                assert(out[j] == buf_sizes[b] && "`strlen_batch` implementation failed");
+            }
+        }
 #endif
-        driver_strnlen(NSAMPLES, bench_reps[b], samples_new, new_strnlen_aarch64_sve, s, buf_sizes[b]);
+
+        // Warmup runs (each implementation until its runtime stabilizes)
+        size_t const warmup_reps = determine_warmup_reps(nreps);
+        for (size_t i = 0; i < nimpls; ++i) {
+            strlen_batch_fn_t* strlen_batch_fn = (strlen_batch_fn_t*)impls[i].fn;
+            warmup_t w = bench_warmup_start();
+            double t;
+            do {
+                driver_strlen_batch(1, warmup_reps, &t, strlen_batch_fn, ptrs, BATCH_NSTRINGS, out);
+            } while (!bench_warmup_steady(&w, t));
+            strlen_bench.warmup[i] = w;
+        }
+
+        // Run benchmark
+        size_t const nslots = bench_schedule(nimpls, NSAMPLES, slots);
+        for (size_t k = 0; k < nslots; ++k) {
+            size_t const i = slots[k].impl;
+            size_t const e = slots[k].sample;
+            strlen_batch_fn_t* strlen_batch_fn = (strlen_batch_fn_t*)impls[i].fn;
+            driver_strlen_batch(
+                1, nreps, &samples[i][e], strlen_batch_fn, ptrs, BATCH_NSTRINGS, out
+            );
+        }
 
         // Process and display results
-        bench_process(&strnlen_bench, NSAMPLES, samples_old, samples_new);
-        bench_print(&strnlen_bench);
+        per_string_samples(nimpls, NSAMPLES, samples);
+        bench_process(&strlen_bench, NSAMPLES, samples);
+        bench_print(&strlen_bench);
 
         // Cleanup
-        free(s);
+        free(buf);
+    }
+}
+
+void bench_strcmp_batch(size_t nbench, size_t const buf_sizes[nbench], size_t const bench_reps[nbench]) {
+    static impl_t const registry[] = {
+#ifdef CMP_LIBC
+        IMPL("strcmp loop (GNU libc 2.39)", strcmp_loop, CPU_FEAT_NONE),
+#else
+        IMPL("strcmp loop (Arm OR 23.01)", __strcmp_aarch64_sve_loop, CPU_FEAT_SVE),
+#endif
+        IMPL("strcmp loop (LI-PaRAD)", new_strcmp_aarch64_sve_loop, CPU_FEAT_SVE),
+        IMPL("strcmp_batch (LI-PaRAD)", new_strcmp_batch_aarch64_sve, CPU_FEAT_SVE),
+        IMPL("strcmp loop (AdvSIMD)", advsimd_strcmp_aarch64_loop, CPU_FEAT_NONE),
+    };
+    impl_t impls[BENCH_MAX_IMPLS];
+    size_t const nimpls = bench_select(NIMPLS(registry), registry, impls);
+    double samples[BENCH_MAX_IMPLS][NSAMPLES] = { 0 };
+    sample_slot_t slots[BENCH_MAX_IMPLS * NSAMPLES];
+
+    for (size_t b = 0; b < nbench; ++b) {
+        // Benchmark initialization (runtimes are reported per string)
+        size_t const nreps = bench_reps[b] > BATCH_NSTRINGS ? bench_reps[b] / BATCH_NSTRINGS : 1;
+        benchmark_t strcmp_bench = {
+            .routine = "strcmp_batch",
+            .impls = impls,
+            .nimpls = nimpls,
+            .nsamples = NSAMPLES,
+            .nreps = nreps,
+            .buf_size = buf_sizes[b],
+            .traffic = TRAFFIC_READ2,
+        };
+
+        // Random ASCII initialization
+        char* buf1 = alloc(BATCH_NSTRINGS * (buf_sizes[b] + 1));
+        char* buf2 = alloc(BATCH_NSTRINGS * (buf_sizes[b] + 1));
+        char const* s1[BATCH_NSTRINGS];
+        char const* s2[BATCH_NSTRINGS];
+        int32_t out[BATCH_NSTRINGS];
+        for (size_t j = 0; j < BATCH_NSTRINGS; ++j) {
+            char* a = buf1 + j * (buf_sizes[b] + 1);
+            char* c = buf2 + j * (buf_sizes[b] + 1);
+            init_buf_rand(buf_sizes[b], a, true);
+            init_buf_copy(buf_sizes[b], c, a);
+            s1[j] = a;
+            s2[j] = c;
+        }
+
+#ifdef DEBUG
+        for (size_t i = 0; i < nimpls; ++i) {
+            fprintf(stderr, "Checking `%s`\n", impls[i].name);
+            strcmp_batch_fn_t* strcmp_batch_fn = (strcmp_batch_fn_t*)impls[i].fn;
+            memset(out, 0xff, sizeof(out));
+            strcmp_batch_fn(s1, s2, BATCH_NSTRINGS, out);
+            for (size_t j = 0; j < BATCH_NSTRINGS; ++j) {
+                assert(out[j] == strcmp(s1[j], s2[j]) && "`strcmp_batch` implementation failed");
+            }
+        }
+#endif
+
+        // Warmup runs (each implementation until its runtime stabilizes)
+        size_t const warmup_reps = determine_warmup_reps(nreps);
+        for (size_t i = 0; i < nimpls; ++i) {
+            strcmp_batch_fn_t* strcmp_batch_fn = (strcmp_batch_fn_t*)impls[i].fn;
+            warmup_t w = bench_warmup_start();
+            double t;
+            do {
+                driver_strcmp_batch(
+                    1, warmup_reps, &t, strcmp_batch_fn, s1, s2, BATCH_NSTRINGS, out
+                );
+            } while (!bench_warmup_steady(&w, t));
+            strcmp_bench.warmup[i] = w;
+        }
+
+        // Run benchmark
+        size_t const nslots = bench_schedule(nimpls, NSAMPLES, slots);
+        for (size_t k = 0; k < nslots; ++k) {
+            size_t const i = slots[k].impl;
+            size_t const e = slots[k].sample;
+            strcmp_batch_fn_t* strcmp_batch_fn = (strcmp_batch_fn_t*)impls[i].fn;
+            driver_strcmp_batch(
+                1, nreps, &samples[i][e], strcmp_batch_fn, s1, s2, BATCH_NSTRINGS, out
+            );
+        }
+
+        // Process and display results
+        per_string_samples(nimpls, NSAMPLES, samples);
+        bench_process(&strcmp_bench, NSAMPLES, samples);
+        bench_print(&strcmp_bench);
+
+        // Cleanup
+        free(buf1);
+        free(buf2);
+    }
+}
+
+/// Checks an implementation `fn` of a wide-character routine on `n` characters of `a` (and `b`).
+typedef bool wide_check_fn_t(void (*fn)(void), wchar_t* a, wchar_t* b, size_t n);
+
+/// Times `nreps` calls of an implementation `fn` of a wide-character routine through its driver.
+typedef void wide_drive_fn_t(
+    void (*fn)(void), size_t nreps, double* t, wchar_t* a, wchar_t* b, size_t n
+);
+
+/// Benchmarks the implementations of the wide-character `routine` on random UTF-32 strings: `a` is
+/// the input string and, depending on `traffic`, `b` is a copy of it (`TRAFFIC_READ2`), a
+/// destination buffer (`TRAFFIC_COPY`) or `NULL`.
+static void bench_wide(
+    char const* routine,
+    traffic_t traffic,
+    wide_check_fn_t* check,
+    wide_drive_fn_t* drive,
+    size_t n_registry,
+    impl_t const registry[n_registry],
+    size_t nbench,
+    size_t const buf_sizes[nbench],
+    size_t const bench_reps[nbench]
+) {
+    impl_t impls[BENCH_MAX_IMPLS];
+    size_t const nimpls = bench_select(n_registry, registry, impls);
+    double samples[BENCH_MAX_IMPLS][NSAMPLES] = { 0 };
+    sample_slot_t slots[BENCH_MAX_IMPLS * NSAMPLES];
+
+    for (size_t b = 0; b < nbench; ++b) {
+        // Buffer sizes are in bytes, only whole wide characters are benchmarked
+        if (buf_sizes[b] % sizeof(wchar_t) != 0) {
+            continue;
+        }
+        size_t const n = buf_sizes[b] / sizeof(wchar_t);
+
+        // Benchmark initialization
+        benchmark_t wide_bench = {
+            .routine = routine,
+            .impls = impls,
+            .nimpls = nimpls,
+            .nsamples = NSAMPLES,
+            .nreps = bench_reps[b],
+            .buf_size = buf_sizes[b],
+            .elem_size = sizeof(wchar_t),
+            .traffic = traffic,
+        };
+
+        // Random UTF-32 initialization
+        wchar_t* s1 = alloc((n + 1) * sizeof(wchar_t));
+        wchar_t* s2 = NULL;
+        init_wbuf_rand(n, s1);
+        if (traffic == TRAFFIC_READ2 || traffic == TRAFFIC_COPY) {
+            s2 = alloc((n + 1) * sizeof(wchar_t));
+        }
+        if (traffic == TRAFFIC_READ2) {
+            memcpy(s2, s1, (n + 1) * sizeof(wchar_t));
+        }
+
+#ifdef DEBUG
+        for (size_t i = 0; i < nimpls; ++i) {
+            fprintf(stderr, "Checking `%s`\n", impls[i].name);
+            assert(check(impls[i].fn, s1, s2, n) && "wide-character implementation failed");
+        }
+#else
+        (void)check;
+#endif
+
+        // Warmup runs (each implementation until its runtime stabilizes)
+        size_t const warmup_reps = determine_warmup_reps(bench_reps[b]);
+        for (size_t i = 0; i < nimpls; ++i) {
+            warmup_t w = bench_warmup_start();
+            double t;
+            do {
+                drive(impls[i].fn, warmup_reps, &t, s1, s2, n);
+            } while (!bench_warmup_steady(&w, t));
+            wide_bench.warmup[i] = w;
+        }
+
+        // Run benchmark
+        size_t const nslots = bench_schedule(nimpls, NSAMPLES, slots);
+        for (size_t k = 0; k < nslots; ++k) {
+            size_t const i = slots[k].impl;
+            size_t const e = slots[k].sample;
+            drive(impls[i].fn, bench_reps[b], &samples[i][e], s1, s2, n);
+        }
+
+        // Process and display results
+        bench_process(&wide_bench, NSAMPLES, samples);
+        bench_print(&wide_bench);
+
+        // Cleanup
+        free(s1);
+        free(s2);
+    }
+}
+
+/// Defines `bench_<routine>` on top of `bench_wide`, comparing the GNU libc, new SVE and C
+/// reference implementations. `check` is the correctness check of an implementation `fn` on `n`
+/// characters of `a` (and `b`), the remaining arguments are those of `driver_<routine>` after `fn`.
+#define WIDE_BENCH(routine, traffic, check, ...)                                                   \
+    static bool check_##routine(void (*f)(void), wchar_t* a, wchar_t* b, size_t n) {               \
+        routine##_fn_t* fn = (routine##_fn_t*)f;                                                   \
+        (void)a, (void)b, (void)n;                                                                 \
+        return check;                                                                              \
+    }                                                                                              \
+    static void drive_##routine(                                                                   \
+        void (*f)(void), size_t nreps, double* t, wchar_t* a, wchar_t* b, size_t n                 \
+    ) {                                                                                            \
+        routine##_fn_t* fn = (routine##_fn_t*)f;                                                   \
+        (void)a, (void)b, (void)n;                                                                 \
+        driver_##routine(1, nreps, t, fn, __VA_ARGS__);                                            \
+    }                                                                                              \
+    void bench_##routine(                                                                          \
+        size_t nbench, size_t const buf_sizes[nbench], size_t const bench_reps[nbench]             \
+    ) {                                                                                            \
+        static impl_t const registry[] = {                                                         \
+            IMPL(#routine " (GNU libc 2.39)", routine, CPU_FEAT_NONE),                             \
+            IMPL(#routine " (LI-PaRAD)", new_##routine##_aarch64_sve, CPU_FEAT_SVE),               \
+            IMPL(#routine " (C reference)", ref_##routine, CPU_FEAT_NONE),                         \
+        };                                                                                         \
+        bench_wide(                                                                                \
+            #routine, traffic, check_##routine, drive_##routine, NIMPLS(registry), registry,       \
+            nbench, buf_sizes, bench_reps                                                          \
+        );                                                                                         \
+    }
+
+/// Checks that a `wcsncpy` implementation copies `n` characters of `a` to `b`, and pads `b` with
+/// zeros up to `n` characters when `a` is shorter (`a` is cut in half for the check).
+static bool check_wcsncpy_padding(wcsncpy_fn_t* fn, wchar_t* a, wchar_t* b, size_t n) {
+    fn(b, a, n);
+    if (wcsncmp(a, b, n) != 0) {
+        return false;
+    }
+    size_t const half = n / 2;
+    wchar_t const c = a[half];
+    a[half] = L'\0';
+    fn(b, a, n);
+    a[half] = c;
+    for (size_t i = half; i < n; ++i) {
+        if (b[i] != L'\0') {
+            return false;
+        }
+    }
+    return wmemcmp(a, b, half) == 0;
+}
+
+// Searches look for L'\0', copies write `b` from `a`
+WIDE_BENCH(wcslen, TRAFFIC_READ, fn(a) == n, a)
+WIDE_BENCH(wcsnlen, TRAFFIC_READ, fn(a, n * 2) == n, a, n)
+WIDE_BENCH(wcscmp, TRAFFIC_READ2, fn(a, b) == wcscmp(a, b), a, b)
+WIDE_BENCH(wcsncmp, TRAFFIC_READ2, fn(a, b, n) == wcsncmp(a, b, n), a, b, n)
+WIDE_BENCH(wcschr, TRAFFIC_READ, fn(a, 0) == wcschr(a, 0), a, 0)
+WIDE_BENCH(wmemchr, TRAFFIC_READ, fn(a, 0, n) == wmemchr(a, 0, n), a, 0, n)
+WIDE_BENCH(wcscpy, TRAFFIC_COPY, (fn(b, a), wcscmp(a, b) == 0), b, a)
+WIDE_BENCH(wcsncpy, TRAFFIC_COPY, check_wcsncpy_padding(fn, a, b, n), b, a, n)
+
+void bench_utf8_validate(
+    size_t nbench, size_t const buf_sizes[nbench], size_t const bench_reps[nbench]
+) {
+    // One registry per corpus (see `utf8_corpus_t`), so that results are labelled with it
+#define UTF8_VALIDATE_REGISTRY(corpus)                                                             \
+    {                                                                                              \
+        IMPL("utf8_validate " corpus " (AdvSIMD)", advsimd_utf8_validate_aarch64, CPU_FEAT_NONE),  \
+        IMPL("utf8_validate " corpus " (LI-PaRAD)", new_utf8_validate_aarch64_sve, CPU_FEAT_SVE),  \
+        IMPL("utf8_validate " corpus " (C reference)", ref_utf8_validate, CPU_FEAT_NONE),          \
+    }
+    static impl_t const registry[][3] = {
+        UTF8_VALIDATE_REGISTRY("ASCII"),
+        UTF8_VALIDATE_REGISTRY("mixed"),
+        UTF8_VALIDATE_REGISTRY("CJK"),
+    };
+#undef UTF8_VALIDATE_REGISTRY
+    double samples[BENCH_MAX_IMPLS][NSAMPLES] = { 0 };
+    sample_slot_t slots[BENCH_MAX_IMPLS * NSAMPLES];
+
+    for (size_t corpus = 0; corpus < NIMPLS(registry); ++corpus) {
+        impl_t impls[BENCH_MAX_IMPLS];
+        size_t const nimpls = bench_select(NIMPLS(registry[corpus]), registry[corpus], impls);
+
+        for (size_t b = 0; b < nbench; ++b) {
+            // Benchmark initialization
+            benchmark_t utf8_validate_bench = {
+                .routine = "utf8_validate",
+                .impls = impls,
+                .nimpls = nimpls,
+                .nsamples = NSAMPLES,
+                .nreps = bench_reps[b],
+                .buf_size = buf_sizes[b],
+            };
+
+            // Random UTF-8 initialization
+            char* s = alloc(buf_sizes[b] + 1);
+            init_buf_utf8(buf_sizes[b], s, (utf8_corpus_t)corpus);
+
+#ifdef DEBUG
+            char* invalid = alloc(buf_sizes[b] + 1);
+            memcpy(invalid, s, buf_sizes[b] + 1);
+            invalid[buf_sizes[b] / 2] = (char)0xff; // Never valid in UTF-8
+            for (size_t i = 0; i < nimpls; ++i) {
+                fprintf(stderr, "Checking `%s`\n", impls[i].name);
+                utf8_validate_fn_t* validate_fn = (utf8_validate_fn_t*)impls[i].fn;
+                assert(
+                    validate_fn(s, buf_sizes[b]) == 1 && "`utf8_validate` implementation failed"
+                );
+                assert(
+                    validate_fn(invalid, buf_sizes[b]) == 0 &&
+                    "`utf8_validate` implementation failed"
+                );
+            }
+            free(invalid);
+#endif
+
+            // Warmup runs (each implementation until its runtime stabilizes)
+            size_t const warmup_reps = determine_warmup_reps(bench_reps[b]);
+            for (size_t i = 0; i < nimpls; ++i) {
+                utf8_validate_fn_t* validate_fn = (utf8_validate_fn_t*)impls[i].fn;
+                warmup_t w = bench_warmup_start();
+                double t;
+                do {
+                    driver_utf8_validate(1, warmup_reps, &t, validate_fn, s, buf_sizes[b]);
+                } while (!bench_warmup_steady(&w, t));
+                utf8_validate_bench.warmup[i] = w;
+            }
+
+            // Run benchmark
+            size_t const nslots = bench_schedule(nimpls, NSAMPLES, slots);
+            for (size_t k = 0; k < nslots; ++k) {
+                size_t const i = slots[k].impl;
+                size_t const e = slots[k].sample;
+                utf8_validate_fn_t* validate_fn = (utf8_validate_fn_t*)impls[i].fn;
+                driver_utf8_validate(
+                    1, bench_reps[b], &samples[i][e], validate_fn, s, buf_sizes[b]
+                );
+            }
+
+            // Process and display results
+            bench_process(&utf8_validate_bench, NSAMPLES, samples);
+            bench_print(&utf8_validate_bench);
+
+            // Cleanup
+            free(s);
+        }
+    }
+}
+
+void bench_utf8_count_codepoints(
+    size_t nbench, size_t const buf_sizes[nbench], size_t const bench_reps[nbench]
+) {
+    // One registry per corpus (see `utf8_corpus_t`), so that results are labelled with it
+#define UTF8_COUNT_REGISTRY(corpus)                                                                \
+    {                                                                                              \
+        IMPL(                                                                                      \
+            "utf8_count " corpus " (AdvSIMD)",                                                     \
+            advsimd_utf8_count_codepoints_aarch64, CPU_FEAT_NONE                                   \
+        ),                                                                                         \
+        IMPL(                                                                                      \
+            "utf8_count " corpus " (LI-PaRAD)",                                                    \
+            new_utf8_count_codepoints_aarch64_sve, CPU_FEAT_SVE                                    \
+        ),                                                                                         \
+        IMPL(                                                                                      \
+            "utf8_count " corpus " (C reference)",                                                 \
+            ref_utf8_count_codepoints, CPU_FEAT_NONE                                               \
+        ),                                                                                         \
+    }
+    static impl_t const registry[][3] = {
+        UTF8_COUNT_REGISTRY("ASCII"),
+        UTF8_COUNT_REGISTRY("mixed"),
+        UTF8_COUNT_REGISTRY("CJK"),
+    };
+#undef UTF8_COUNT_REGISTRY
+    double samples[BENCH_MAX_IMPLS][NSAMPLES] = { 0 };
+    sample_slot_t slots[BENCH_MAX_IMPLS * NSAMPLES];
+
+    for (size_t corpus = 0; corpus < NIMPLS(registry); ++corpus) {
+        impl_t impls[BENCH_MAX_IMPLS];
+        size_t const nimpls = bench_select(NIMPLS(registry[corpus]), registry[corpus], impls);
+
+        for (size_t b = 0; b < nbench; ++b) {
+            // Benchmark initialization
+            benchmark_t utf8_count_codepoints_bench = {
+                .routine = "utf8_count_codepoints",
+                .impls = impls,
+                .nimpls = nimpls,
+                .nsamples = NSAMPLES,
+                .nreps = bench_reps[b],
+                .buf_size = buf_sizes[b],
+            };
+
+            // Random UTF-8 initialization
+            char* s = alloc(buf_sizes[b] + 1);
+            size_t const ncodepoints = init_buf_utf8(buf_sizes[b], s, (utf8_corpus_t)corpus);
+            (void)ncodepoints; // Only checked in debug builds
+
+#ifdef DEBUG
+            for (size_t i = 0; i < nimpls; ++i) {
+                fprintf(stderr, "Checking `%s`\n", impls[i].name);
+                utf8_count_codepoints_fn_t* count_fn = (utf8_count_codepoints_fn_t*)impls[i].fn;
+                assert(
+                    count_fn(s, buf_sizes[b]) == ncodepoints &&
+                    "`utf8_count_codepoints` implementation failed"
+                );
+            }
+#endif
+
+            // Warmup runs (each implementation until its runtime stabilizes)
+            size_t const warmup_reps = determine_warmup_reps(bench_reps[b]);
+            for (size_t i = 0; i < nimpls; ++i) {
+                utf8_count_codepoints_fn_t* count_fn = (utf8_count_codepoints_fn_t*)impls[i].fn;
+                warmup_t w = bench_warmup_start();
+                double t;
+                do {
+                    driver_utf8_count_codepoints(1, warmup_reps, &t, count_fn, s, buf_sizes[b]);
+                } while (!bench_warmup_steady(&w, t));
+                utf8_count_codepoints_bench.warmup[i] = w;
+            }
+
+            // Run benchmark
+            size_t const nslots = bench_schedule(nimpls, NSAMPLES, slots);
+            for (size_t k = 0; k < nslots; ++k) {
+                size_t const i = slots[k].impl;
+                size_t const e = slots[k].sample;
+                utf8_count_codepoints_fn_t* count_fn = (utf8_count_codepoints_fn_t*)impls[i].fn;
+                driver_utf8_count_codepoints(
+                    1, bench_reps[b], &samples[i][e], count_fn, s, buf_sizes[b]
+                );
+            }
+
+            // Process and display results
+            bench_process(&utf8_count_codepoints_bench, NSAMPLES, samples);
+            bench_print(&utf8_count_codepoints_bench);
+
+            // Cleanup
+            free(s);
+        }
+    }
+}
+
+/// CPU features required by the kernels of a tree of implementations (see `PIPELINE_STAGES`).
+#define PIPELINE_FEAT_libc CPU_FEAT_NONE
+#define PIPELINE_FEAT_arm CPU_FEAT_SVE
+#define PIPELINE_FEAT_new CPU_FEAT_SVE
+
+#define PIPELINE_IMPL(scenario, first, second)                                                     \
+    IMPL(                                                                                          \
+        #scenario " " #first "+" #second, pipeline_##scenario##_##first##_##second,                \
+        PIPELINE_FEAT_##first | PIPELINE_FEAT_##second                                             \
+    ),
+
+/// Number of records of the pipeline corpora (about 4 KiB, 64 KiB and 1 MiB of text).
+static size_t const pipeline_nrecords[] = { 64, 1024, 16384 };
+#define PIPELINE_NSIZES (sizeof(pipeline_nrecords) / sizeof(pipeline_nrecords[0]))
+
+/// Number of repetitions of the pipeline benchmarks (about 64Ki records per sample).
+static inline size_t pipeline_reps(size_t nrecords) {
+    return nrecords < 65536 ? 65536 / nrecords : 1;
+}
+
+/// Runs composite scenarios chaining two routines over a generated corpus, with every combination
+/// of stage implementations (the element throughput is in records per second).
+void bench_pipeline(void) {
+    static impl_t const registry[PIPELINE_NSCENARIOS][PIPELINE_NIMPLS] = {
+        [PIPELINE_CSV] = { PIPELINE_STAGES(PIPELINE_IMPL, csv) },
+        [PIPELINE_KV] = { PIPELINE_STAGES(PIPELINE_IMPL, kv) },
+        [PIPELINE_PATH] = { PIPELINE_STAGES(PIPELINE_IMPL, path) },
+    };
+    double samples[BENCH_MAX_IMPLS][NSAMPLES] = { 0 };
+    sample_slot_t slots[BENCH_MAX_IMPLS * NSAMPLES];
+
+    for (size_t s = 0; s < PIPELINE_NSCENARIOS; ++s) {
+        impl_t impls[BENCH_MAX_IMPLS];
+        size_t const nimpls = bench_select(PIPELINE_NIMPLS, registry[s], impls);
+
+        for (size_t b = 0; b < PIPELINE_NSIZES; ++b) {
+            // Random corpus initialization
+            pipeline_corpus_t corpus =
+                pipeline_corpus_init((pipeline_scenario_t)s, pipeline_nrecords[b]);
+
+            // Benchmark initialization (the buffer is the whole corpus)
+            size_t const nreps = pipeline_reps(pipeline_nrecords[b]);
+            benchmark_t pipeline_bench = {
+                .routine = "pipeline",
+                .impls = impls,
+                .nimpls = nimpls,
+                .nsamples = NSAMPLES,
+                .nreps = nreps,
+                .buf_size = corpus.size,
+                .nelems = pipeline_nrecords[b],
+                .traffic = TRAFFIC_NONE,
+            };
+
+#ifdef DEBUG
+            size_t const expected = ((pipeline_fn_t*)impls[0].fn)(&corpus);
+            for (size_t i = 0; i < nimpls; ++i) {
+                fprintf(stderr, "Checking `%s`\n", impls[i].name);
+                pipeline_fn_t* pipeline_fn = (pipeline_fn_t*)impls[i].fn;
+                assert(pipeline_fn(&corpus) == expected && "pipeline implementation failed");
+            }
+#endif
+
+            // Warmup runs (each implementation until its runtime stabilizes)
+            size_t const warmup_reps = determine_warmup_reps(nreps);
+            for (size_t i = 0; i < nimpls; ++i) {
+                pipeline_fn_t* pipeline_fn = (pipeline_fn_t*)impls[i].fn;
+                warmup_t w = bench_warmup_start();
+                double t;
+                do {
+                    driver_pipeline(1, warmup_reps, &t, pipeline_fn, &corpus);
+                } while (!bench_warmup_steady(&w, t));
+                pipeline_bench.warmup[i] = w;
+            }
+
+            // Run benchmark
+            size_t const nslots = bench_schedule(nimpls, NSAMPLES, slots);
+            for (size_t k = 0; k < nslots; ++k) {
+                size_t const i = slots[k].impl;
+                size_t const e = slots[k].sample;
+                pipeline_fn_t* pipeline_fn = (pipeline_fn_t*)impls[i].fn;
+                driver_pipeline(1, nreps, &samples[i][e], pipeline_fn, &corpus);
+            }
+
+            // Process and display results
+            bench_process(&pipeline_bench, NSAMPLES, samples);
+            bench_print(&pipeline_bench);
+
+            // Cleanup
+            pipeline_corpus_free(&corpus);
+        }
     }
 }
 
@@ -616,54 +2173,204 @@ int32_t main(int32_t argc, char *argv[argc + 1]) {
         {"memcpy",  no_argument, 0, 'x'},
         {"strcmp",  no_argument, 0, 'e'},
         {"strncmp", no_argument, 0, 'p'},
+        {"strcasecmp",  no_argument, 0, 'i'},
+        {"strncasecmp", no_argument, 0, 'k'},
         {"strchr",  no_argument, 0, 's'},
         {"strrchr", no_argument, 0, 'r'},
         {"strcpy",  no_argument, 0, 'c'},
         {"strncpy", no_argument, 0, 'y'},
         {"strlen",  no_argument, 0, 'l'},
         {"strnlen", no_argument, 0, 'n'},
+        {"strlen-batch", no_argument, 0, 'L'},
+        {"strcmp-batch", no_argument, 0, 'E'},
+        {"sampling", required_argument, 0, 'S'},
+        {"count",   no_argument, 0, 'C'},
+        {"latency", no_argument, 0, 'H'},
+        {"fit",     no_argument, 0, 'F'},
+        {"roofline", no_argument, 0, 'R'},
+        {"noise",   required_argument, 0, 'N'},
+        {"latency-dump", required_argument, 0, OPT_LATENCY_DUMP},
+        {"corun",   required_argument, 0, OPT_CORUN},
+        {"direct",  required_argument, 0, OPT_DIRECT},
+        {"call-overhead", no_argument, 0, OPT_CALL_OVERHEAD},
+        {"campaign", required_argument, 0, OPT_CAMPAIGN},
+        {"tune",    required_argument, 0, 'T'},
+        {"dispatch", required_argument, 0, 'D'},
+        {"memcpy-pollution", no_argument, 0, 'P'},
+        {"par-memcpy", no_argument, 0, 'X'},
+        {"par-memcmp", no_argument, 0, 'M'},
+        {"wcslen",  no_argument, 0, OPT_WCSLEN},
+        {"wcsnlen", no_argument, 0, OPT_WCSNLEN},
+        {"wcscmp",  no_argument, 0, OPT_WCSCMP},
+        {"wcsncmp", no_argument, 0, OPT_WCSNCMP},
+        {"wcschr",  no_argument, 0, OPT_WCSCHR},
+        {"wmemchr", no_argument, 0, OPT_WMEMCHR},
+        {"wcscpy",  no_argument, 0, OPT_WCSCPY},
+        {"wcsncpy", no_argument, 0, OPT_WCSNCPY},
+        {"utf8-validate", no_argument, 0, OPT_UTF8_VALIDATE},
+        {"utf8-count", no_argument, 0, OPT_UTF8_COUNT},
+        {"pipeline", no_argument, 0, OPT_PIPELINE},
         {"help",    no_argument, 0, 'h'},
         {"version", no_argument, 0, 'v'},
         {0,         0,           0, 0},
     };
 
+    // Before any option pins the benchmark thread
+    par_save_affinity();
+
     while (true) {
         int32_t optidx = 0;
-        int32_t opt = getopt_long(argc, argv, "mxepsrcylnhv", longopts, &optidx);
+        int32_t opt = getopt_long(argc, argv, "mxepiksrcylnLEPXMS:CHFRN:T:D:hv", longopts, &optidx);
         if (opt == -1) {
             break;
         }
 
         switch (opt) {
             case 'm':
-                bench_memcmp(nbench, buf_sizes, bench_reps);
+                RUN_DIRECT(bench_memcmp(nbench, buf_sizes, bench_reps));
                 break;
             case 'x':
-                bench_memcpy(nbench, buf_sizes, bench_reps);
+                RUN_DIRECT(bench_memcpy(nbench, buf_sizes, bench_reps));
                 break;
             case 'e':
-                bench_strcmp(nbench, buf_sizes, bench_reps);
+                RUN_DIRECT(bench_strcmp(nbench, buf_sizes, bench_reps));
                 break;
             case 'p':
-                bench_strncmp(nbench, buf_sizes, bench_reps);
+                RUN_DIRECT(bench_strncmp(nbench, buf_sizes, bench_reps));
+                break;
+            case 'i':
+                RUN(bench_strcasecmp(nbench, buf_sizes, bench_reps));
+                break;
+            case 'k':
+                RUN(bench_strncasecmp(nbench, buf_sizes, bench_reps));
                 break;
             case 's':
-                bench_strchr(nbench, buf_sizes, bench_reps);
+                RUN_DIRECT(bench_strchr(nbench, buf_sizes, bench_reps));
                 break;
             case 'r':
-                bench_strrchr(nbench, buf_sizes, bench_reps);
+                RUN_DIRECT(bench_strrchr(nbench, buf_sizes, bench_reps));
                 break;
             case 'c':
-                bench_strcpy(nbench, buf_sizes, bench_reps);
+                RUN_DIRECT(bench_strcpy(nbench, buf_sizes, bench_reps));
                 break;
             case 'y':
-                bench_strncpy(nbench, buf_sizes, bench_reps);
+                RUN_DIRECT(bench_strncpy(nbench, buf_sizes, bench_reps));
                 break;
             case 'l':
-                bench_strlen(nbench, buf_sizes, bench_reps);
+                RUN_DIRECT(bench_strlen(nbench, buf_sizes, bench_reps));
                 break;
             case 'n':
-                bench_strnlen(nbench, buf_sizes, bench_reps);
+                RUN_DIRECT(bench_strnlen(nbench, buf_sizes, bench_reps));
+                break;
+            case 'L':
+                RUN(bench_strlen_batch(nbench, buf_sizes, bench_reps));
+                break;
+            case 'E':
+                RUN(bench_strcmp_batch(nbench, buf_sizes, bench_reps));
+                break;
+            case 'P':
+                RUN(bench_memcpy_pollution());
+                break;
+            case 'X':
+                RUN(bench_par_memcpy());
+                break;
+            case 'M':
+                RUN(bench_par_memcmp());
+                break;
+            case OPT_WCSLEN:
+                RUN(bench_wcslen(nbench, buf_sizes, bench_reps));
+                break;
+            case OPT_WCSNLEN:
+                RUN(bench_wcsnlen(nbench, buf_sizes, bench_reps));
+                break;
+            case OPT_WCSCMP:
+                RUN(bench_wcscmp(nbench, buf_sizes, bench_reps));
+                break;
+            case OPT_WCSNCMP:
+                RUN(bench_wcsncmp(nbench, buf_sizes, bench_reps));
+                break;
+            case OPT_WCSCHR:
+                RUN(bench_wcschr(nbench, buf_sizes, bench_reps));
+                break;
+            case OPT_WMEMCHR:
+                RUN(bench_wmemchr(nbench, buf_sizes, bench_reps));
+                break;
+            case OPT_WCSCPY:
+                RUN(bench_wcscpy(nbench, buf_sizes, bench_reps));
+                break;
+            case OPT_WCSNCPY:
+                RUN(bench_wcsncpy(nbench, buf_sizes, bench_reps));
+                break;
+            case OPT_UTF8_VALIDATE:
+                RUN(bench_utf8_validate(nbench, buf_sizes, bench_reps));
+                break;
+            case OPT_UTF8_COUNT:
+                RUN(bench_utf8_count_codepoints(nbench, buf_sizes, bench_reps));
+                break;
+            case OPT_PIPELINE:
+                RUN(bench_pipeline());
+                break;
+            case 'S': {
+                sampling_t sampling;
+                if (!bench_parse_sampling(optarg, &sampling)) {
+                    fprintf(stderr, "Invalid sampling order `%s`\n", optarg);
+                    exit(1);
+                }
+                bench_set_sampling(sampling);
+                break;
+            }
+            case 'C':
+                bench_set_counting(true);
+                break;
+            case 'H':
+                bench_set_latency(true);
+                break;
+            case 'F':
+                model_set_enabled(true);
+                break;
+            case 'R':
+                roofline_calibrate();
+                break;
+            case 'N': {
+                noise_mode_t mode;
+                if (!noise_parse_mode(optarg, &mode)) {
+                    fprintf(stderr, "Invalid noise mode `%s`\n", optarg);
+                    exit(1);
+                }
+                noise_set_mode(mode);
+                break;
+            }
+            case OPT_LATENCY_DUMP:
+                if (!bench_set_latency_dump(optarg)) {
+                    fprintf(stderr, "Failed to open `%s`\n", optarg);
+                    exit(1);
+                }
+                break;
+            case OPT_CORUN:
+                if (!corun_add(optarg)) {
+                    fprintf(stderr, "Invalid co-runner `%s`\n", optarg);
+                    exit(1);
+                }
+                break;
+            case OPT_DIRECT: {
+                size_t unroll;
+                if (!direct_parse_unroll(optarg, &unroll)) {
+                    fprintf(stderr, "Invalid unroll factor `%s`\n", optarg);
+                    exit(1);
+                }
+                direct_set_unroll(unroll);
+                break;
+            }
+            case OPT_CALL_OVERHEAD:
+                direct_set_report(true);
+                break;
+            case OPT_CAMPAIGN:
+                exit(campaign_run(optarg) ? 0 : 1);
+            case 'T':
+                tune(nbench, buf_sizes, bench_reps, optarg);
+                break;
+            case 'D':
+                dispatch_set_output(optarg);
                 break;
             case 'h':
                 help();
@@ -677,8 +2384,12 @@ int32_t main(int32_t argc, char *argv[argc + 1]) {
         }
     }
 
+    dispatch_write();
+    model_report();
+    corun_report();
+    direct_report();
     return 0;
 }
 #else
-#error "Target CPU must support the (Arm OR 23.01)"
+#error "Target CPU must be AArch64"
 #endif
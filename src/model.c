@@ -0,0 +1,204 @@
+/**
+ * Copyright © 2004 - 2024, Université de Versailles Saint-Quentin-en-Yvelines (UVSQ)
+ * Copyright © 2024, Gabriel Dos Santos
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ **/
+
+#define _GNU_SOURCE
+
+#include "model.h"
+#include "corun.h"
+#include "direct.h"
+#include "utils.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// Number of cache regimes: up to the L1, L2 and L3 sizes, then memory.
+#define MODEL_NREGIMES 4
+
+/// Measurements of an implementation over the sweep.
+typedef struct model_series_s {
+    /// Benchmark and implementation names.
+    char const* routine;
+    char const* name;
+    /// Series of the reference implementation of the benchmark that recorded it first.
+    size_t ref;
+    size_t npoints;
+    double size[MODEL_MAX_POINTS];
+    double rt[MODEL_MAX_POINTS];
+} model_series_t;
+
+/// Linear fit `rt = a + b * size` of the points of a cache regime.
+typedef struct model_fit_s {
+    size_t npoints;
+    double a;
+    double b;
+    double r2;
+} model_fit_t;
+
+static bool model_enabled = false;
+static model_series_t model_series[MODEL_MAX_SERIES];
+static size_t model_nseries = 0;
+
+void model_set_enabled(bool enabled) {
+    model_enabled = enabled;
+}
+
+/// Series of implementation `name` in benchmark `routine` (the same implementation measured by
+/// different benchmarks, e.g. `memcpy` and `par_memcpy`, has runtimes that do not fit together).
+static size_t find_series(char const* routine, char const* name) {
+    routine = routine != NULL ? routine : "";
+    for (size_t s = 0; s < model_nseries; ++s) {
+        model_series_t const* self = &model_series[s];
+        if (strcmp(self->routine, routine) == 0 && strcmp(self->name, name) == 0) {
+            return s;
+        }
+    }
+    assert(model_nseries < MODEL_MAX_SERIES && "too many implementations in cost model");
+    model_series_t* self = &model_series[model_nseries];
+    self->routine = routine;
+    self->name = name;
+    self->ref = model_nseries;
+    self->npoints = 0;
+    return model_nseries++;
+}
+
+void model_record(benchmark_t const bench[static 1]) {
+    // Runs under co-runner load and call overhead reruns would skew the fit of the sweep
+    if (!model_enabled || bench->no_model || bench_counting() || corun_loaded() || direct_rerun() ||
+        bench->nimpls == 0) {
+        return;
+    }
+    size_t const ref = find_series(bench->routine, bench->impls[0].name);
+    for (size_t i = 0; i < bench->nimpls; ++i) {
+        size_t const s = find_series(bench->routine, bench->impls[i].name);
+        model_series_t* self = &model_series[s];
+        if (self->npoints == 0) {
+            self->ref = ref;
+        }
+        assert(self->npoints < MODEL_MAX_POINTS && "too many buffer sizes in cost model");
+        self->size[self->npoints] = (double)bench->buf_size;
+        self->rt[self->npoints] = bench->rt[i].avg;
+        self->npoints += 1;
+    }
+}
+
+/// Ordinary least squares fit of the points of `self` with sizes in `(lo, hi]`.
+static model_fit_t fit(model_series_t const self[static 1], double lo, double hi) {
+    model_fit_t f = { 0 };
+    double sx = 0.0, sy = 0.0;
+    for (size_t p = 0; p < self->npoints; ++p) {
+        if (self->size[p] > lo && self->size[p] <= hi) {
+            sx += self->size[p];
+            sy += self->rt[p];
+            f.npoints += 1;
+        }
+    }
+    if (f.npoints < 2) {
+        return f;
+    }
+    double const mx = sx / (double)f.npoints;
+    double const my = sy / (double)f.npoints;
+    double sxx = 0.0, sxy = 0.0, syy = 0.0;
+    for (size_t p = 0; p < self->npoints; ++p) {
+        if (self->size[p] > lo && self->size[p] <= hi) {
+            double const dx = self->size[p] - mx;
+            double const dy = self->rt[p] - my;
+            sxx += dx * dx;
+            sxy += dx * dy;
+            syy += dy * dy;
+        }
+    }
+    // A single buffer size: no slope to fit
+    if (sxx == 0.0) {
+        f.npoints = 0;
+        return f;
+    }
+    f.b = sxy / sxx;
+    f.a = my - f.b * mx;
+    f.r2 = syy > 0.0 ? sxy * sxy / (sxx * syy) : 1.0;
+    return f;
+}
+
+void model_report(void) {
+    if (!model_enabled || model_nseries == 0) {
+        return;
+    }
+
+    static char const* const regimes[MODEL_NREGIMES] = { "L1", "L2", "L3", "DRAM" };
+    size_t caches[3];
+    cache_sizes(caches);
+    double const ghz = cpu_freq_ghz();
+    // Upper bound of each regime (missing cache levels are merged with the next regime)
+    double bounds[MODEL_NREGIMES];
+    for (size_t r = 0; r < 3; ++r) {
+        bounds[r] = caches[r] > 0 ? (double)caches[r] : r > 0 ? bounds[r - 1] : 0.0;
+    }
+    bounds[3] = 1.0e300;
+
+    printf(
+        "\nCost model (time = a + b * n per cache regime): L1 %zu KiB, L2 %zu KiB, L3 %zu KiB, ",
+        caches[0] >> 10, caches[1] >> 10, caches[2] >> 10
+    );
+    if (ghz > 0.0) {
+        printf("%.2lf GHz\n", ghz);
+    } else {
+        printf("unknown frequency\n");
+    }
+    printf(
+        "%22s |%30s |%7s |%7s |%12s |%12s |%12s |%8s |%15s |%15s\n", "BENCHMARK",
+        "ROUTINE IMPLEMENTATION", "REGIME", "POINTS", "STARTUP ns", "B/ns", "B/CYCLE", "R2",
+        "STARTUP DIFF ns", "B/ns DIFF %"
+    );
+
+    for (size_t s = 0; s < model_nseries; ++s) {
+        model_series_t const* self = &model_series[s];
+        for (size_t r = 0; r < MODEL_NREGIMES; ++r) {
+            double const lo = r > 0 ? bounds[r - 1] : 0.0;
+            if (bounds[r] <= lo) {
+                continue;
+            }
+            model_fit_t const f = fit(self, lo, bounds[r]);
+            if (f.npoints == 0) {
+                continue;
+            }
+            // Asymptotic throughput (none if the runtime does not grow with the size)
+            double const bpns = f.b > 0.0 ? 1.0 / f.b : 0.0;
+            printf(
+                "%22s |%30s |%7s |%7zu |%12.3lf |%12.3lf |", self->routine, self->name, regimes[r],
+                f.npoints, f.a, bpns
+            );
+            if (ghz > 0.0 && bpns > 0.0) {
+                printf("%12.3lf |", bpns / ghz);
+            } else {
+                printf("%12s |", "-");
+            }
+            printf("%8.4lf |", f.r2);
+
+            // Differences with the reference implementation in the same regime
+            model_fit_t const g = fit(&model_series[self->ref], lo, bounds[r]);
+            if (self->ref != s && g.npoints > 0 && g.b > 0.0 && bpns > 0.0) {
+                printf("%+15.3lf |%+14.2lf%%\n", f.a - g.a, (bpns * g.b - 1.0) * 100.0);
+            } else {
+                printf("%15s |%15s\n", "-", "-");
+            }
+        }
+    }
+}
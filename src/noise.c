@@ -0,0 +1,193 @@
+/**
+ * Copyright © 2004 - 2024, Université de Versailles Saint-Quentin-en-Yvelines (UVSQ)
+ * Copyright © 2024, Gabriel Dos Santos
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ **/
+
+#define _GNU_SOURCE
+
+#include "noise.h"
+#include "bench.h"
+#include "utils.h"
+
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+
+/// Load average (1 minute) above which the machine is reported as busy.
+#define NOISE_MAX_LOAD 1.0
+
+static noise_mode_t noise = NOISE_OFF;
+
+/// Disturbances of the samples of the implementations called since the last `noise_reset`.
+static struct {
+    void (*fn)(void);
+    size_t nsamples;
+    uint8_t flags[NOISE_MAX_SAMPLES];
+} noise_samples[BENCH_MAX_IMPLS];
+static size_t noise_nimpls = 0;
+
+bool noise_parse_mode(char const* name, noise_mode_t mode[static 1]) {
+    static struct {
+        char const* name;
+        noise_mode_t mode;
+    } const names[] = {
+        { "off", NOISE_OFF },
+        { "flag", NOISE_FLAG },
+        { "reject", NOISE_REJECT },
+    };
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); ++i) {
+        if (strcmp(name, names[i].name) == 0) {
+            *mode = names[i].mode;
+            return true;
+        }
+    }
+    return false;
+}
+
+void noise_set_mode(noise_mode_t mode) {
+    noise = mode;
+    if (mode != NOISE_OFF) {
+        noise_environment();
+    }
+}
+
+noise_mode_t noise_mode(void) {
+    return noise;
+}
+
+/// Returns whether `cpu` is in a CPU list of sysfs (comma-separated CPUs and ranges, e.g. `2,4-7`).
+static bool in_cpu_list(char const* list, int32_t cpu) {
+    char const* p = list;
+    while (*p >= '0' && *p <= '9') {
+        char* end;
+        long const lo = strtol(p, &end, 10);
+        long const hi = *end == '-' ? strtol(end + 1, &end, 10) : lo;
+        if (cpu >= lo && cpu <= hi) {
+            return true;
+        }
+        p = *end == ',' ? end + 1 : end;
+    }
+    return false;
+}
+
+void noise_environment(void) {
+    int32_t const cpu = sched_getcpu();
+    char path[96], buf[256];
+    printf("# cpu: %d\n", cpu);
+
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cpufreq/scaling_governor", cpu);
+    if (read_sysfs(path, sizeof(buf), buf)) {
+        printf("# governor: %s\n", buf);
+        if (strcmp(buf, "performance") != 0) {
+            fprintf(stderr, "Warning: CPU %d uses the `%s` frequency governor\n", cpu, buf);
+        }
+    } else {
+        printf("# governor: unknown\n");
+    }
+
+    if (!read_sysfs("/sys/devices/system/cpu/isolated", sizeof(buf), buf)) {
+        buf[0] = '\0';
+    }
+    printf("# isolcpus: %s\n", buf[0] != '\0' ? buf : "none");
+    if (!in_cpu_list(buf, cpu)) {
+        fprintf(stderr, "Warning: CPU %d is not isolated (`isolcpus`)\n", cpu);
+    }
+    if (read_sysfs("/sys/devices/system/cpu/nohz_full", sizeof(buf), buf)) {
+        printf("# nohz_full: %s\n", buf[0] != '\0' && buf[0] != '(' ? buf : "none");
+    }
+
+    // The selected mode is in brackets (e.g. `always [madvise] never`)
+    if (read_sysfs("/sys/kernel/mm/transparent_hugepage/enabled", sizeof(buf), buf)) {
+        char const* open = strchr(buf, '[');
+        char const* close = open != NULL ? strchr(open, ']') : NULL;
+        if (open != NULL && close != NULL) {
+            printf("# thp: %.*s\n", (int)(close - open - 1), open + 1);
+            if (strncmp(open + 1, "always", 6) == 0) {
+                fprintf(stderr, "Warning: transparent huge pages are always enabled\n");
+            }
+        }
+    }
+
+    if (read_sysfs("/proc/loadavg", sizeof(buf), buf)) {
+        double load[3] = { 0.0 };
+        sscanf(buf, "%lf %lf %lf", &load[0], &load[1], &load[2]);
+        printf("# loadavg: %.2lf %.2lf %.2lf\n", load[0], load[1], load[2]);
+        if (load[0] > NOISE_MAX_LOAD) {
+            fprintf(stderr, "Warning: load average of %.2lf\n", load[0]);
+        }
+    }
+}
+
+noise_t noise_snapshot(void) {
+    struct rusage usage;
+    getrusage(RUSAGE_THREAD, &usage);
+    return (noise_t){
+        .cpu = sched_getcpu(),
+        .nivcsw = usage.ru_nivcsw,
+        .nflt = usage.ru_minflt + usage.ru_majflt,
+    };
+}
+
+uint32_t noise_compare(noise_t const before[static 1], noise_t const after[static 1]) {
+    uint32_t flags = 0;
+    if (after->nivcsw != before->nivcsw) {
+        flags |= NOISE_PREEMPTED;
+    }
+    if (after->cpu != before->cpu) {
+        flags |= NOISE_MIGRATED;
+    }
+    if (after->nflt != before->nflt) {
+        flags |= NOISE_FAULTED;
+    }
+    return flags;
+}
+
+void noise_record(void (*fn)(void), uint32_t flags) {
+    size_t i = 0;
+    while (i < noise_nimpls && noise_samples[i].fn != fn) {
+        i += 1;
+    }
+    if (i == noise_nimpls) {
+        // Calls of implementations that do not fit (warmup calls of other benchmarks)
+        if (noise_nimpls == BENCH_MAX_IMPLS) {
+            return;
+        }
+        noise_samples[i].fn = fn;
+        noise_samples[i].nsamples = 0;
+        memset(noise_samples[i].flags, 0, sizeof(noise_samples[i].flags));
+        noise_nimpls += 1;
+    }
+    if (noise_samples[i].nsamples < NOISE_MAX_SAMPLES) {
+        noise_samples[i].flags[noise_samples[i].nsamples++] = (uint8_t)flags;
+    }
+}
+
+uint8_t const* noise_flags(void (*fn)(void)) {
+    for (size_t i = 0; i < noise_nimpls; ++i) {
+        if (noise_samples[i].fn == fn) {
+            return noise_samples[i].flags;
+        }
+    }
+    return NULL;
+}
+
+void noise_reset(void) {
+    noise_nimpls = 0;
+}
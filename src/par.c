@@ -0,0 +1,232 @@
+/**
+ * Copyright © 2004 - 2024, Université de Versailles Saint-Quentin-en-Yvelines (UVSQ)
+ * Copyright © 2024, Gabriel Dos Santos
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ **/
+
+#define _GNU_SOURCE
+
+#include "par.h"
+#include "driver.h"
+
+#include <assert.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/// Parallel call split over the threads of the pool.
+typedef struct par_job_s {
+    /// Runs part `p` of the job.
+    void (*run)(struct par_job_s* self, size_t p);
+    /// Number of parts (one per thread).
+    size_t nparts;
+    /// Buffers (chunk boundaries are page-aligned in `a`).
+    void* a;
+    void const* b;
+    size_t n;
+    /// Result of each part (`memcmp` only).
+    int32_t results[PAR_MAX_THREADS];
+} par_job_t;
+
+static pthread_once_t par_once = PTHREAD_ONCE_INIT;
+static pthread_t par_threads[PAR_MAX_THREADS];
+static size_t par_size = 1;
+/// CPUs the threads are pinned to (the first one is left to the calling thread).
+static int32_t par_cpus[PAR_MAX_THREADS];
+static size_t par_page;
+/// Affinity mask of the process at startup, from which the pool is built.
+static cpu_set_t par_affinity;
+static bool par_affinity_saved = false;
+/// Affinity mask of the calling thread saved by `par_bind`.
+static cpu_set_t par_caller;
+
+static pthread_mutex_t par_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t par_cond = PTHREAD_COND_INITIALIZER;
+/// Incremented for each job submitted to the workers.
+static size_t par_generation = 0;
+static par_job_t* par_current = NULL;
+/// Number of parts of the current job (a copy that outlives it, read by workers outside it).
+static size_t par_nparts = 0;
+/// Number of worker parts of the current job not done yet.
+static atomic_size_t par_pending = 0;
+
+static void pin(int32_t cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+static void* par_worker(void* arg) {
+    size_t const t = (size_t)(uintptr_t)arg;
+    pin(par_cpus[t]);
+    size_t seen = 0;
+    while (true) {
+        pthread_mutex_lock(&par_mutex);
+        while (par_generation == seen) {
+            pthread_cond_wait(&par_cond, &par_mutex);
+        }
+        seen = par_generation;
+        // Only the workers of the job are waited for: others must not touch it, as it lives on
+        // the stack of a `par_run` that may have returned
+        par_job_t* job = par_current;
+        bool const part_of_job = t < par_nparts;
+        pthread_mutex_unlock(&par_mutex);
+
+        if (part_of_job) {
+            job->run(job, t);
+            atomic_fetch_sub_explicit(&par_pending, 1, memory_order_release);
+        }
+    }
+    return NULL;
+}
+
+static void par_start(void) {
+    par_page = (size_t)sysconf(_SC_PAGESIZE);
+
+    // One thread per CPU of the affinity mask of the process (not of the calling thread, which
+    // may have been pinned since, e.g. by `corun_add`)
+    if (!par_affinity_saved) {
+        par_save_affinity();
+    }
+    par_size = 0;
+    for (int32_t cpu = 0; cpu < CPU_SETSIZE && par_size < PAR_MAX_THREADS; ++cpu) {
+        if (CPU_ISSET(cpu, &par_affinity)) {
+            par_cpus[par_size++] = cpu;
+        }
+    }
+    assert(par_size > 0 && "no CPU available");
+
+    for (size_t t = 1; t < par_size; ++t) {
+        if (pthread_create(&par_threads[t], NULL, par_worker, (void*)(uintptr_t)t) != 0) {
+            fprintf(stderr, "Failed to start thread %zu of the pool\n", t);
+            exit(1);
+        }
+    }
+}
+
+/// Runs `job` on the pool, part 0 on the calling thread.
+static void par_run(par_job_t* job) {
+    pthread_mutex_lock(&par_mutex);
+    par_current = job;
+    par_nparts = job->nparts;
+    atomic_store_explicit(&par_pending, job->nparts - 1, memory_order_relaxed);
+    par_generation += 1;
+    pthread_cond_broadcast(&par_cond);
+    pthread_mutex_unlock(&par_mutex);
+
+    job->run(job, 0);
+    while (atomic_load_explicit(&par_pending, memory_order_acquire) > 0) {
+    }
+}
+
+/// Offset of the end of part `p` of `job`, rounded up to a page boundary of `job->a`.
+static inline size_t part_end(par_job_t const* job, size_t p) {
+    if (p + 1 >= job->nparts) {
+        return job->n;
+    }
+    uintptr_t const base = (uintptr_t)job->a;
+    uintptr_t const end = base + (p + 1) * (job->n / job->nparts);
+    size_t const off = ((end + par_page - 1) & ~(uintptr_t)(par_page - 1)) - base;
+    return off < job->n ? off : job->n;
+}
+
+static inline size_t part_begin(par_job_t const* job, size_t p) {
+    return p == 0 ? 0 : part_end(job, p - 1);
+}
+
+static void run_memcpy(par_job_t* self, size_t p) {
+    size_t const begin = part_begin(self, p);
+    size_t const end = part_end(self, p);
+    new_memcpy_aarch64_sve((char*)self->a + begin, (char const*)self->b + begin, end - begin);
+}
+
+static void run_memcmp(par_job_t* self, size_t p) {
+    size_t const begin = part_begin(self, p);
+    size_t const end = part_end(self, p);
+    self->results[p] = new_memcmp_aarch64_sve(
+        (char const*)self->a + begin, (char const*)self->b + begin, end - begin
+    );
+}
+
+void par_save_affinity(void) {
+    CPU_ZERO(&par_affinity);
+    sched_getaffinity(0, sizeof(par_affinity), &par_affinity);
+    par_affinity_saved = true;
+}
+
+void par_bind(void) {
+    pthread_once(&par_once, par_start);
+    CPU_ZERO(&par_caller);
+    pthread_getaffinity_np(pthread_self(), sizeof(par_caller), &par_caller);
+    pin(par_cpus[0]);
+}
+
+void par_unbind(void) {
+    pthread_setaffinity_np(pthread_self(), sizeof(par_caller), &par_caller);
+}
+
+size_t par_pool_size(void) {
+    pthread_once(&par_once, par_start);
+    return par_size;
+}
+
+size_t par_nthreads(size_t n) {
+    size_t const nthreads = n / PAR_MIN_CHUNK;
+    size_t const size = par_pool_size();
+    return nthreads < 1 ? 1 : nthreads > size ? size : nthreads;
+}
+
+void* par_memcpy_n(size_t nthreads, void* restrict dst, void const* restrict src, size_t n) {
+    size_t const size = par_pool_size();
+    nthreads = nthreads > size ? size : nthreads;
+    if (nthreads <= 1) {
+        return new_memcpy_aarch64_sve(dst, src, n);
+    }
+    par_job_t job = { .run = run_memcpy, .nparts = nthreads, .a = dst, .b = src, .n = n };
+    par_run(&job);
+    return dst;
+}
+
+int32_t par_memcmp_n(size_t nthreads, void const* s1, void const* s2, size_t n) {
+    size_t const size = par_pool_size();
+    nthreads = nthreads > size ? size : nthreads;
+    if (nthreads <= 1) {
+        return new_memcmp_aarch64_sve(s1, s2, n);
+    }
+    par_job_t job = { .run = run_memcmp, .nparts = nthreads, .a = (void*)s1, .b = s2, .n = n };
+    par_run(&job);
+    // The first differing part gives the result
+    for (size_t p = 0; p < nthreads; ++p) {
+        if (job.results[p] != 0) {
+            return job.results[p];
+        }
+    }
+    return 0;
+}
+
+void* par_memcpy(void* restrict dst, void const* restrict src, size_t n) {
+    return par_memcpy_n(par_nthreads(n), dst, src, n);
+}
+
+int32_t par_memcmp(void const* s1, void const* s2, size_t n) {
+    return par_memcmp_n(par_nthreads(n), s1, s2, n);
+}
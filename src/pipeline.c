@@ -0,0 +1,261 @@
+/**
+ * Copyright © 2004 - 2024, Université de Versailles Saint-Quentin-en-Yvelines (UVSQ)
+ * Copyright © 2024, Gabriel Dos Santos
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ **/
+
+#define _GNU_SOURCE
+
+#include "pipeline.h"
+#include "driver.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// Size of the scratch buffers (longer than any generated line or path).
+#define PIPELINE_SCRATCH_SIZE 256
+
+/// Kernel of `routine` in a tree of implementations (see `PIPELINE_STAGES`).
+#define KERNEL(tree, routine) KERNEL_##tree(routine)
+#define KERNEL_libc(routine) routine
+#define KERNEL_arm(routine) __##routine##_aarch64_sve
+#define KERNEL_new(routine) new_##routine##_aarch64_sve
+
+static char const alnum[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+
+/// Writes `n` random alphanumeric characters to `p`. Returns the end of the written characters.
+static char* rand_word(char* p, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        *p++ = alnum[rand() % (int32_t)(sizeof(alnum) - 1)];
+    }
+    return p;
+}
+
+/// Cheap hash of a key of the key-value lookup scenario, from its length and last two bytes (the
+/// keys share prefixes).
+static inline size_t kv_hash(char const* key, size_t len, size_t nbuckets) {
+    size_t const h = len * 31 + (unsigned char)key[len - 1] * 7 + (unsigned char)key[len - 2];
+    return h & (nbuckets - 1);
+}
+
+/// Lines of 4 to 8 comma-separated fields of 1 to 16 characters.
+static void csv_init(pipeline_corpus_t corpus[static 1]) {
+    corpus->text = malloc(corpus->nrecords * PIPELINE_SCRATCH_SIZE);
+    char* p = corpus->text;
+    for (size_t r = 0; r < corpus->nrecords; ++r) {
+        corpus->records[r] = p;
+        size_t const nfields = 4 + (size_t)rand() % 5;
+        for (size_t f = 0; f < nfields; ++f) {
+            p = rand_word(p, 1 + (size_t)rand() % 16);
+            *p++ = f + 1 < nfields ? ',' : '\n';
+        }
+    }
+    *p = '\0';
+    corpus->size = (size_t)(p - corpus->text);
+}
+
+/// Queries of a table of dotted configuration keys: 90% of the queries are keys of the table, the
+/// others only differ from one in the middle (same bucket, so they are compared all the same).
+static void kv_init(pipeline_corpus_t corpus[static 1]) {
+    static char const* const prefixes[] = {
+        "server.", "server.http.", "database.connection.", "cache.", "log.level.",
+    };
+    size_t const nprefixes = sizeof(prefixes) / sizeof(prefixes[0]);
+    size_t const nkeys = corpus->nrecords / 4 + 16;
+    size_t nbuckets = 1;
+    while (nbuckets < nkeys / 2) {
+        nbuckets *= 2;
+    }
+
+    // Keys, then entries sorted by bucket
+    corpus->keys = malloc(nkeys * 64);
+    pipeline_entry_t* keys = malloc(nkeys * sizeof(pipeline_entry_t));
+    char* p = corpus->keys;
+    for (size_t k = 0; k < nkeys; ++k) {
+        char const* prefix = prefixes[(size_t)rand() % nprefixes];
+        size_t const len = strlen(prefix);
+        keys[k].key = p;
+        memcpy(p, prefix, len);
+        p = rand_word(p + len, 4 + (size_t)rand() % 21);
+        keys[k].len = (size_t)(p - keys[k].key);
+        keys[k].value = k + 1;
+        *p++ = '\0';
+    }
+    corpus->entries = malloc(nkeys * sizeof(pipeline_entry_t));
+    corpus->nbuckets = nbuckets;
+    corpus->buckets = calloc(nbuckets + 1, sizeof(size_t));
+    for (size_t k = 0; k < nkeys; ++k) {
+        corpus->buckets[kv_hash(keys[k].key, keys[k].len, nbuckets) + 1] += 1;
+    }
+    for (size_t h = 0; h < nbuckets; ++h) {
+        corpus->buckets[h + 1] += corpus->buckets[h];
+    }
+    size_t* fill = malloc(nbuckets * sizeof(size_t));
+    memcpy(fill, corpus->buckets, nbuckets * sizeof(size_t));
+    for (size_t k = 0; k < nkeys; ++k) {
+        corpus->entries[fill[kv_hash(keys[k].key, keys[k].len, nbuckets)]++] = keys[k];
+    }
+    free(fill);
+
+    // Queries
+    corpus->text = malloc(corpus->nrecords * 64);
+    p = corpus->text;
+    for (size_t r = 0; r < corpus->nrecords; ++r) {
+        pipeline_entry_t const* key = &keys[(size_t)rand() % nkeys];
+        corpus->records[r] = p;
+        memcpy(p, key->key, key->len + 1);
+        if (rand() % 10 == 0) {
+            p[key->len / 2] = '#';
+        }
+        p += key->len + 1;
+    }
+    corpus->size = (size_t)(p - corpus->text);
+    free(keys);
+}
+
+/// Absolute paths of 1 to 6 directories and a file name, with an extension for 80% of them.
+static void path_init(pipeline_corpus_t corpus[static 1]) {
+    static char const* const extensions[] = { ".c", ".h", ".txt", ".json", ".tar.gz" };
+    size_t const nextensions = sizeof(extensions) / sizeof(extensions[0]);
+    corpus->text = malloc(corpus->nrecords * PIPELINE_SCRATCH_SIZE);
+    char* p = corpus->text;
+    for (size_t r = 0; r < corpus->nrecords; ++r) {
+        corpus->records[r] = p;
+        size_t const ndirs = 1 + (size_t)rand() % 6;
+        for (size_t d = 0; d < ndirs; ++d) {
+            *p++ = '/';
+            p = rand_word(p, 1 + (size_t)rand() % 12);
+        }
+        *p++ = '/';
+        p = rand_word(p, 1 + (size_t)rand() % 12);
+        if (rand() % 5 != 0) {
+            char const* ext = extensions[(size_t)rand() % nextensions];
+            size_t const len = strlen(ext);
+            memcpy(p, ext, len);
+            p += len;
+        }
+        *p++ = '\0';
+    }
+    corpus->size = (size_t)(p - corpus->text);
+}
+
+pipeline_corpus_t pipeline_corpus_init(pipeline_scenario_t scenario, size_t nrecords) {
+    pipeline_corpus_t corpus = {
+        .scenario = scenario,
+        .records = malloc(nrecords * sizeof(char const*)),
+        .nrecords = nrecords,
+        .scratch = malloc(PIPELINE_SCRATCH_SIZE),
+        .scratch2 = malloc(PIPELINE_SCRATCH_SIZE),
+    };
+    switch (scenario) {
+        case PIPELINE_CSV:
+            csv_init(&corpus);
+            break;
+        case PIPELINE_KV:
+            kv_init(&corpus);
+            break;
+        case PIPELINE_PATH:
+            path_init(&corpus);
+            break;
+    }
+    return corpus;
+}
+
+void pipeline_corpus_free(pipeline_corpus_t corpus[static 1]) {
+    free(corpus->text);
+    free(corpus->records);
+    free(corpus->entries);
+    free(corpus->buckets);
+    free(corpus->keys);
+    free(corpus->scratch);
+    free(corpus->scratch2);
+}
+
+/// CSV tokenizing: each line is copied to a NUL-terminated buffer, then each of its fields.
+/// Returns the total length of the fields.
+#define PIPELINE_CSV(scenario, first, second)                                                      \
+    size_t pipeline_csv_##first##_##second(pipeline_corpus_t const* corpus) {                      \
+        char* line = corpus->scratch;                                                              \
+        char* field = corpus->scratch2;                                                            \
+        char const* p = corpus->text;                                                              \
+        size_t sum = 0;                                                                            \
+        for (size_t r = 0; r < corpus->nrecords; ++r) {                                            \
+            char const* eol = KERNEL(first, strchr)(p, '\n');                                      \
+            size_t const len = (size_t)(eol - p);                                                  \
+            KERNEL(second, memcpy)(line, p, len);                                                  \
+            line[len] = '\0';                                                                      \
+            char const* f = line;                                                                  \
+            char const* comma;                                                                     \
+            while ((comma = KERNEL(first, strchr)(f, ',')) != NULL) {                              \
+                KERNEL(second, memcpy)(field, f, (size_t)(comma - f));                             \
+                field[comma - f] = '\0';                                                           \
+                sum += (size_t)(comma - f);                                                        \
+                f = comma + 1;                                                                     \
+            }                                                                                      \
+            KERNEL(second, memcpy)(field, f, len - (size_t)(f - line) + 1);                        \
+            sum += len - (size_t)(f - line);                                                       \
+            p = eol + 1;                                                                           \
+        }                                                                                          \
+        return sum;                                                                                \
+    }
+
+/// Key-value lookup: each query is hashed from its length, then compared to the keys of its
+/// bucket of the same length. Returns the sum of the values found.
+#define PIPELINE_KV(scenario, first, second)                                                       \
+    size_t pipeline_kv_##first##_##second(pipeline_corpus_t const* corpus) {                       \
+        size_t sum = 0;                                                                            \
+        for (size_t r = 0; r < corpus->nrecords; ++r) {                                            \
+            char const* query = corpus->records[r];                                                \
+            size_t const len = KERNEL(first, strlen)(query);                                       \
+            size_t const h = kv_hash(query, len, corpus->nbuckets);                                \
+            for (size_t e = corpus->buckets[h]; e < corpus->buckets[h + 1]; ++e) {                 \
+                pipeline_entry_t const* entry = &corpus->entries[e];                               \
+                if (entry->len == len && KERNEL(second, memcmp)(entry->key, query, len) == 0) {    \
+                    sum += entry->value;                                                           \
+                    break;                                                                         \
+                }                                                                                  \
+            }                                                                                      \
+        }                                                                                          \
+        return sum;                                                                                \
+    }
+
+/// Path manipulation: each path is copied and split in its directory, and the stem and extension
+/// of its file name. Returns the total length of the directories and stems.
+#define PIPELINE_PATH(scenario, first, second)                                                     \
+    size_t pipeline_path_##first##_##second(pipeline_corpus_t const* corpus) {                     \
+        char* dir = corpus->scratch;                                                               \
+        char* name = corpus->scratch2;                                                             \
+        size_t sum = 0;                                                                            \
+        for (size_t r = 0; r < corpus->nrecords; ++r) {                                            \
+            KERNEL(second, strcpy)(dir, corpus->records[r]);                                       \
+            char* slash = KERNEL(first, strrchr)(dir, '/');                                        \
+            KERNEL(second, strcpy)(name, slash + 1);                                               \
+            *slash = '\0';                                                                         \
+            char* dot = KERNEL(first, strrchr)(name, '.');                                         \
+            if (dot != NULL) {                                                                     \
+                *dot = '\0';                                                                       \
+                sum += (size_t)(dot - name);                                                       \
+            }                                                                                      \
+            sum += (size_t)(slash - dir);                                                          \
+        }                                                                                          \
+        return sum;                                                                                \
+    }
+
+PIPELINE_STAGES(PIPELINE_CSV, csv)
+PIPELINE_STAGES(PIPELINE_KV, kv)
+PIPELINE_STAGES(PIPELINE_PATH, path)
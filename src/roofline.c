@@ -0,0 +1,149 @@
+/**
+ * Copyright © 2004 - 2024, Université de Versailles Saint-Quentin-en-Yvelines (UVSQ)
+ * Copyright © 2024, Gabriel Dos Santos
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ **/
+
+#define _GNU_SOURCE
+
+#include "roofline.h"
+#include "utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/// Smallest working set of the DRAM level (in bytes).
+#define ROOFLINE_DRAM_MIN (256ULL << 20)
+
+/// Bytes streamed per timed pass (small working sets are streamed several times).
+#define ROOFLINE_PASS_BYTES (64ULL << 20)
+
+static char const* const roofline_levels[ROOFLINE_NLEVELS] = { "L1", "L2", "L3", "DRAM" };
+static bool roofline_calibrated = false;
+/// Capacity of each level (0 if absent, `SIZE_MAX` for DRAM).
+static size_t roofline_capacity[ROOFLINE_NLEVELS];
+/// Bandwidth of each kernel on each level (in GiB/s, bytes copied for copies).
+static double roofline_read[ROOFLINE_NLEVELS];
+static double roofline_write[ROOFLINE_NLEVELS];
+static double roofline_copy[ROOFLINE_NLEVELS];
+
+typedef enum stream_e {
+    STREAM_READ,
+    STREAM_WRITE,
+    STREAM_COPY,
+} stream_t;
+
+/// Runs a streaming kernel over a working set of `n` bytes (two halves for copies) `reps` times.
+static inline void stream_run(stream_t stream, char* buf, size_t n, size_t reps) {
+    // Keeps the loads of the read kernel from being optimized out
+    static volatile uint64_t sink;
+    for (size_t r = 0; r < reps; ++r) {
+        switch (stream) {
+            case STREAM_READ:
+                sink += stream_read_aarch64_sve(buf, n);
+                break;
+            case STREAM_WRITE:
+                stream_write_aarch64_sve(buf, n);
+                break;
+            case STREAM_COPY:
+                stream_copy_aarch64_sve(buf, buf + n / 2, n / 2);
+                break;
+        }
+    }
+}
+
+/// Best bandwidth of a streaming kernel over a working set of `n` bytes (in GiB/s).
+static double stream_bandwidth(stream_t stream, char* buf, size_t n) {
+    size_t const reps = n < ROOFLINE_PASS_BYTES ? ROOFLINE_PASS_BYTES / n : 1;
+    // Bytes counted per pass (bytes copied for copies)
+    size_t const bytes = stream == STREAM_COPY ? n / 2 : n;
+    stream_run(stream, buf, n, 1);
+    double best = 0.0;
+    for (size_t t = 0; t < ROOFLINE_NTRIALS; ++t) {
+        struct timespec a, b;
+        clock_gettime(CLOCK_MONOTONIC_RAW, &a);
+        stream_run(stream, buf, n, reps);
+        clock_gettime(CLOCK_MONOTONIC_RAW, &b);
+        double const bw = (double)(bytes * reps) / ONE_GIB / ns_to_s(elapsed_ns(a, b));
+        best = bw > best ? bw : best;
+    }
+    return best;
+}
+
+void roofline_calibrate(void) {
+    size_t caches[3];
+    cache_sizes(caches);
+    size_t llc = 0;
+    for (size_t l = 0; l < 3; ++l) {
+        roofline_capacity[l] = caches[l];
+        llc = caches[l] > llc ? caches[l] : llc;
+    }
+    roofline_capacity[ROOFLINE_NLEVELS - 1] = SIZE_MAX;
+    size_t const dram = 4 * llc > ROOFLINE_DRAM_MIN ? 4 * llc : ROOFLINE_DRAM_MIN;
+
+    char* buf = malloc(dram);
+    if (buf == NULL) {
+        fprintf(stderr, "Failed to allocate the roofline buffer\n");
+        exit(1);
+    }
+    memset(buf, 1, dram);
+
+    printf(
+        "%8s |%16s |%15s |%15s |%15s\n", "LEVEL", "WORKING SET B", "READ GiB/s", "WRITE GiB/s",
+        "COPY GiB/s"
+    );
+    for (size_t l = 0; l < ROOFLINE_NLEVELS; ++l) {
+        if (roofline_capacity[l] == 0) {
+            continue;
+        }
+        size_t const n = l + 1 < ROOFLINE_NLEVELS ? roofline_capacity[l] / 2 : dram;
+        roofline_read[l] = stream_bandwidth(STREAM_READ, buf, n);
+        roofline_write[l] = stream_bandwidth(STREAM_WRITE, buf, n);
+        roofline_copy[l] = stream_bandwidth(STREAM_COPY, buf, n);
+        printf(
+            "%8s |%16zu |%15.3lf |%15.3lf |%15.3lf\n", roofline_levels[l], n, roofline_read[l],
+            roofline_write[l], roofline_copy[l]
+        );
+    }
+    printf("\n");
+    free(buf);
+    roofline_calibrated = true;
+}
+
+double roofline_percent(benchmark_t const bench[static 1], size_t i) {
+    if (!roofline_calibrated || bench->traffic == TRAFFIC_NONE) {
+        return -1.0;
+    }
+    // Smallest level holding the working set of the routine
+    size_t const ws = bench->traffic == TRAFFIC_READ ? bench->buf_size : 2 * bench->buf_size;
+    size_t l = 0;
+    while (l + 1 < ROOFLINE_NLEVELS && roofline_capacity[l] < ws) {
+        l += 1;
+    }
+    switch (bench->traffic) {
+        case TRAFFIC_READ:
+            return bench->bw[i].avg / roofline_read[l] * 100.0;
+        case TRAFFIC_READ2:
+            return 2.0 * bench->bw[i].avg / roofline_read[l] * 100.0;
+        case TRAFFIC_COPY:
+            return bench->bw[i].avg / roofline_copy[l] * 100.0;
+        default:
+            return -1.0;
+    }
+}
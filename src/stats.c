@@ -37,3 +37,14 @@ double stddev(size_t n, double const d[n], double mean) {
     }
     return sqrt(s / (double)(n - 1));
 }
+
+paired_t paired_diff(size_t n, double const a[n], double const b[n]) {
+    double d[n];
+    for (size_t i = 0; i < n; ++i) {
+        d[i] = b[i] - a[i];
+    }
+    paired_t p = { .avg = mean(n, d) };
+    // Normal approximation of the Student t-distribution (samples count is large)
+    p.ci95 = 1.96 * stddev(n, d, p.avg) / sqrt((double)n);
+    return p;
+}
@@ -24,6 +24,20 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <sys/auxv.h>
+#include <sys/prctl.h>
+
+#ifndef HWCAP_SVE
+    #define HWCAP_SVE (1 << 22)
+#endif
+#ifndef HWCAP2_SVE2
+    #define HWCAP2_SVE2 (1 << 1)
+#endif
+#ifndef PR_SVE_GET_VL
+    #define PR_SVE_GET_VL 51
+    #define PR_SVE_VL_LEN_MASK 0xffff
+#endif
 
 #define BIN_NAME "bench-sve-string-routines"
 #define VERSION_MAJOR 0
@@ -38,6 +52,77 @@ inline double ns_to_s(double ns) {
     return ns * 1.0e-9;
 }
 
+uint32_t cpu_features(void) {
+    static uint32_t features = UINT32_MAX;
+    if (features == UINT32_MAX) {
+        unsigned long const hwcap = getauxval(AT_HWCAP);
+        features = CPU_FEAT_NONE;
+        if (hwcap & HWCAP_SVE) {
+            features |= CPU_FEAT_SVE;
+            // Vector length of the thread (in bytes)
+            int32_t const vl = prctl(PR_SVE_GET_VL);
+            if (vl >= 0 && (vl & PR_SVE_VL_LEN_MASK) == 16) {
+                features |= CPU_FEAT_VL128;
+            } else if (vl >= 0 && (vl & PR_SVE_VL_LEN_MASK) == 32) {
+                features |= CPU_FEAT_VL256;
+            }
+        }
+        unsigned long const hwcap2 = getauxval(AT_HWCAP2);
+        if (hwcap2 & HWCAP2_SVE2) {
+            features |= CPU_FEAT_SVE2;
+        }
+    }
+    return features;
+}
+
+bool read_sysfs(char const* path, size_t n, char buf[n]) {
+    FILE* f = fopen(path, "r");
+    if (f == NULL) {
+        return false;
+    }
+    bool const ok = fgets(buf, (int)n, f) != NULL;
+    fclose(f);
+    buf[strcspn(buf, "\n")] = '\0';
+    return ok;
+}
+
+void cache_sizes(size_t sizes[static 3]) {
+    memset(sizes, 0, 3 * sizeof(size_t));
+    for (size_t i = 0;; ++i) {
+        char path[96];
+        char level[32], type[32], size[32];
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%zu/level", i);
+        if (!read_sysfs(path, sizeof(level), level)) {
+            break;
+        }
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%zu/type", i);
+        if (!read_sysfs(path, sizeof(type), type) || strcmp(type, "Instruction") == 0) {
+            continue;
+        }
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%zu/size", i);
+        if (!read_sysfs(path, sizeof(size), size)) {
+            continue;
+        }
+        // Sizes are written with a `K` or `M` suffix
+        char* end;
+        size_t bytes = strtoull(size, &end, 10);
+        bytes <<= *end == 'M' ? 20 : *end == 'K' ? 10 : 0;
+        size_t const l = strtoull(level, NULL, 10);
+        if (l >= 1 && l <= 3) {
+            sizes[l - 1] = bytes;
+        }
+    }
+}
+
+double cpu_freq_ghz(void) {
+    char khz[32];
+    char const* path = "/sys/devices/system/cpu/cpu0/cpufreq/cpuinfo_max_freq";
+    if (!read_sysfs(path, sizeof(khz), khz)) {
+        return 0.0;
+    }
+    return (double)strtoull(khz, NULL, 10) * 1.0e-6;
+}
+
 int32_t cmp_double(void const* a, void const* b) {
     if (*(double const*)a > *(double const*)b) {
         return 1;
@@ -75,6 +160,87 @@ inline void init_buf_copy(size_t n, char* buf_dst, char const* buf_src) {
     buf_dst[n] = '\0';
 }
 
+// Assumes both buffers have the same length `n` (and allocated size `n + 1`)
+inline void init_buf_swapcase(size_t n, char* buf_dst, char const* buf_src) {
+    assert(buf_dst != NULL && "destination buffer cannot be nullptr");
+    assert(buf_src != NULL && "source buffer cannot be nullptr");
+    for (size_t i = 0; i < n; ++i) {
+        char c = buf_src[i];
+        if (c >= 'a' && c <= 'z') {
+            c = (char)(c - 'a' + 'A');
+        } else if (c >= 'A' && c <= 'Z') {
+            c = (char)(c - 'A' + 'a');
+        }
+        buf_dst[i] = c;
+    }
+    buf_dst[n] = '\0';
+}
+
+// Assumes buffer has allocated size `n + 1`
+inline void init_wbuf_rand(size_t n, wchar_t* buf) {
+    assert(buf != NULL && "buffer cannot be nullptr");
+    for (size_t i = 0; i < n; ++i) {
+        // Random code point out of the surrogates range, mostly in the BMP
+        wchar_t c;
+        do {
+            c = (wchar_t)(rand() % (i % 8 == 0 ? 0x10ffff : 0xffff) + 1);
+        } while (c >= 0xd800 && c <= 0xdfff);
+        buf[i] = c;
+    }
+    buf[n] = 0;
+}
+
+/// Random code point of a UTF-8 corpus.
+static uint32_t corpus_codepoint(utf8_corpus_t corpus) {
+    uint32_t const r = (uint32_t)rand() % 100;
+    uint32_t const ascii = (uint32_t)rand() % 95 + 32;
+    switch (corpus) {
+        case UTF8_MIXED:
+            if (r < 70) {
+                return ascii;
+            } else if (r < 85) {
+                return 0xc0 + (uint32_t)rand() % 0x1c0; // Latin-1 Supplement and Latin Extended
+            } else if (r < 95) {
+                return 0x4e00 + (uint32_t)rand() % 0x5200; // CJK Unified Ideographs
+            } else {
+                return 0x1f300 + (uint32_t)rand() % 0x300; // Emojis and pictographs
+            }
+        case UTF8_CJK:
+            return r < 10 ? ascii : 0x4e00 + (uint32_t)rand() % 0x5200;
+        case UTF8_ASCII:
+        default:
+            return ascii;
+    }
+}
+
+// Assumes buffer has allocated size `n + 1`
+size_t init_buf_utf8(size_t n, char* buf, utf8_corpus_t corpus) {
+    assert(buf != NULL && "buffer cannot be nullptr");
+    unsigned char* p = (unsigned char*)buf;
+    size_t count = 0;
+    for (size_t i = 0; i < n; ++count) {
+        uint32_t const cp = corpus_codepoint(corpus);
+        size_t const len = cp < 0x80 ? 1 : cp < 0x800 ? 2 : cp < 0x10000 ? 3 : 4;
+        if (i + len > n) {
+            // Pad with ASCII rather than truncate a sequence
+            p[i++] = (unsigned char)((uint32_t)rand() % 95 + 32);
+            continue;
+        }
+        if (len == 1) {
+            p[i] = (unsigned char)cp;
+        } else {
+            // Lead byte: `len` high bits set, then the high bits of the code point
+            p[i] = (unsigned char)((0xf00u >> len) | (cp >> (6 * (len - 1))));
+            for (size_t k = 1; k < len; ++k) {
+                p[i + k] = (unsigned char)(0x80 | ((cp >> (6 * (len - 1 - k))) & 0x3f));
+            }
+        }
+        i += len;
+    }
+    buf[n] = '\0';
+    return count;
+}
+
 void help(void) {
     fprintf(stderr, "Comparative benchmarks for implementations of Arm SVE optimized string routines\n");
     fprintf(stderr, "Copyright (C) 2024, Laboratoire LI-PaRAD, UVSQ\n\n");
@@ -86,11 +252,79 @@ void help(void) {
     fprintf(stderr, "\t-m, --memcmp   Runs benchmark for the `memcmp` routine\n");
     fprintf(stderr, "\t-e, --strcmp   Runs benchmark for the `strcmp` routine\n");
     fprintf(stderr, "\t-p, --strncmp  Runs benchmark for the `strncmp` routine\n");
+    fprintf(stderr, "\t-i, --strcasecmp  Runs benchmark for the `strcasecmp` routine\n");
+    fprintf(stderr, "\t-k, --strncasecmp  Runs benchmark for the `strncasecmp` routine\n");
     fprintf(stderr, "\t-s, --strchr   Runs benchmark for the `strchr` routine\n");
     fprintf(stderr, "\t-r, --strrchr  Runs benchmark for the `strrchr` routine\n");
     fprintf(stderr, "\t-l, --strlen   Runs benchmark for the `strlen` routine\n");
     fprintf(stderr, "\t-n, --strnlen  Runs benchmark for the `strnlen` routine\n");
+    fprintf(stderr, "\t-L, --strlen-batch  Runs benchmark for batched `strlen` over many strings\n");
+    fprintf(stderr, "\t-E, --strcmp-batch  Runs benchmark for batched `strcmp` over many strings\n");
+    fprintf(stderr, "\t-P, --memcpy-pollution  Runs benchmark for the bandwidth of large `memcpy`\n");
+    fprintf(stderr, "\t               and the slowdown of re-reading a hot working set after them\n");
+    fprintf(stderr, "\t-X, --par-memcpy  Runs benchmark for multi-threaded `memcpy` per thread count\n");
+    fprintf(stderr, "\t-M, --par-memcmp  Runs benchmark for multi-threaded `memcmp` per thread count\n");
+    fprintf(stderr, "\t    --wcslen, --wcsnlen, --wcscmp, --wcsncmp, --wcschr, --wmemchr, --wcscpy,\n");
+    fprintf(stderr, "\t    --wcsncpy  Runs benchmark for the given wide-character routine\n");
+    fprintf(stderr, "\t    --utf8-validate, --utf8-count\n");
+    fprintf(stderr, "\t               Runs benchmark for UTF-8 validation or code-point counting\n");
+    fprintf(stderr, "\t               on ASCII, mixed and CJK text\n");
+    fprintf(stderr, "\t    --pipeline  Runs benchmark for CSV tokenizing, key-value lookup and path\n");
+    fprintf(stderr, "\t               manipulation pipelines, with every combination of stages\n");
+    fprintf(stderr, "\t-T, --tune <FILE>\n");
+    fprintf(stderr, "\t               Benchmarks every generated kernel variant and writes the fastest\n");
+    fprintf(stderr, "\t               one of each size class to <FILE> (CSV)\n");
     fprintf(stderr, "\nFLAGS:\n");
+    fprintf(stderr, "\t-S, --sampling <ORDER>\n");
+    fprintf(stderr, "\t               Order in which samples of the implementations are collected\n");
+    fprintf(stderr, "\t               (`blocked`, `abab`, `abba` or `random`, defaults to `random`);\n");
+    fprintf(stderr, "\t               must precede the routines it applies to\n");
+    fprintf(stderr, "\t-C, --count    Calls each implementation once between instruction counting\n");
+    fprintf(stderr, "\t               markers instead of timing it (see `scripts/icount.sh`);\n");
+    fprintf(stderr, "\t               must precede the routines it applies to\n");
+    fprintf(stderr, "\t-H, --latency  Times each call individually with the generic timer and prints\n");
+    fprintf(stderr, "\t               the P50, P90, P99, P99.9 and maximum latencies instead;\n");
+    fprintf(stderr, "\t               must precede the routines it applies to\n");
+    fprintf(stderr, "\t-F, --fit      Fits a cost model (startup cost and throughput per cache regime)\n");
+    fprintf(stderr, "\t               to the runtimes of each implementation over the buffer sizes,\n");
+    fprintf(stderr, "\t               printed after all benchmarks; must precede the routines\n");
+    fprintf(stderr, "\t-R, --roofline Measures the read, write and copy bandwidths of each cache level\n");
+    fprintf(stderr, "\t               and DRAM, and reports results as a percentage of them;\n");
+    fprintf(stderr, "\t               must precede the routines it applies to\n");
+    fprintf(stderr, "\t-N, --noise <MODE>\n");
+    fprintf(stderr, "\t               Prints the environment of the run (governor, isolated CPUs,\n");
+    fprintf(stderr, "\t               huge pages, load) and records the preemptions, migrations and\n");
+    fprintf(stderr, "\t               page faults of each sample: `flag` reports disturbed samples,\n");
+    fprintf(stderr, "\t               `reject` also leaves them out of the statistics, `off` (default)\n");
+    fprintf(stderr, "\t               does neither; must precede the routines it applies to\n");
+    fprintf(stderr, "\t    --latency-dump <FILE>\n");
+    fprintf(stderr, "\t               Same as `--latency`, and writes the latency histograms to\n");
+    fprintf(stderr, "\t               <FILE> (CSV)\n");
+    fprintf(stderr, "\t    --corun <KIND>[@<INTENSITY>]:<CPU>[,<CPU>...]\n");
+    fprintf(stderr, "\t               Starts co-runner threads on each CPU (a number, or `sibling` for\n");
+    fprintf(stderr, "\t               an SMT sibling of the benchmark thread): `bw` (bandwidth hog),\n");
+    fprintf(stderr, "\t               `chase` (latency hog) or `llc` (LLC thrasher), running\n");
+    fprintf(stderr, "\t               <INTENSITY> percent of the time (defaults to 100); routines\n");
+    fprintf(stderr, "\t               run isolated, then loaded, and slowdowns are printed after all\n");
+    fprintf(stderr, "\t               benchmarks; may be repeated, must precede the routines\n");
+    fprintf(stderr, "\t    --direct <UNROLL>\n");
+    fprintf(stderr, "\t               Times the `mem*`, `str*` and `str*len` routines by calling each\n");
+    fprintf(stderr, "\t               implementation by symbol, <UNROLL> (1, 4 or 8) calls per loop\n");
+    fprintf(stderr, "\t               iteration, instead of through a function pointer;\n");
+    fprintf(stderr, "\t               must precede the routines it applies to\n");
+    fprintf(stderr, "\t    --call-overhead\n");
+    fprintf(stderr, "\t               Runs the same routines through function pointers, then by\n");
+    fprintf(stderr, "\t               symbol at each unroll factor, and reports the overhead of the\n");
+    fprintf(stderr, "\t               former after all benchmarks; must precede the routines\n");
+    fprintf(stderr, "\t    --campaign <FILE>\n");
+    fprintf(stderr, "\t               Runs the matrix of routines, builds and SVE vector lengths of\n");
+    fprintf(stderr, "\t               <FILE> in parallel, one process per physical core, and exits;\n");
+    fprintf(stderr, "\t               finished runs are checkpointed, so that an interrupted campaign\n");
+    fprintf(stderr, "\t               resumes (see `include/campaign.h` for the format of <FILE>)\n");
+    fprintf(stderr, "\t-D, --dispatch <FILE>\n");
+    fprintf(stderr, "\t               Writes the fastest implementation of each buffer size of the\n");
+    fprintf(stderr, "\t               `memcpy`, `memcmp`, `strncmp`, `strnlen` and `strncpy` benchmarks\n");
+    fprintf(stderr, "\t               to <FILE>, as a dispatch table (C header)\n");
     fprintf(stderr, "\t-h, --help     Prints this help and exits\n");
     fprintf(stderr, "\t-v, --version  Prints version and exits\n");
 }
@@ -0,0 +1,34 @@
+/**
+ * Copyright © 2004 - 2024, Université de Versailles Saint-Quentin-en-Yvelines (UVSQ)
+ * Copyright © 2024, Gabriel Dos Santos
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ **/
+
+#pragma once
+
+#include "types.h"
+
+#include <arm_sve.h>
+
+// Implementations are built by GCC and Clang from the same sources, `ACLE_CC` (`gcc` or `clang`)
+// distinguishes their symbols: `ACLE_FN(strlen)` is `acle_gcc_strlen_aarch64_sve` for GCC.
+#ifndef ACLE_CC
+    #error "ACLE_CC must name the compiler building the ACLE implementations"
+#endif
+#define ACLE_FN(name) ACLE_FN_1(ACLE_CC, name)
+#define ACLE_FN_1(cc, name) ACLE_FN_2(cc, name)
+#define ACLE_FN_2(cc, name) acle_##cc##_##name##_aarch64_sve
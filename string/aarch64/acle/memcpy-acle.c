@@ -0,0 +1,73 @@
+/**
+ * Copyright © 2004 - 2024, Université de Versailles Saint-Quentin-en-Yvelines (UVSQ)
+ * Copyright © 2024, Gabriel Dos Santos
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ **/
+
+#include "acle.h"
+
+/// Copies of at least `MEMCPY_NT_THRESHOLD` bytes use non-temporal loads and stores.
+#ifndef MEMCPY_NT_THRESHOLD
+    #define MEMCPY_NT_THRESHOLD (32ULL << 20)
+#endif
+
+/// Distance (in vectors) at which the source of non-temporal copies is prefetched.
+#ifndef MEMCPY_NT_PREFETCH
+    #define MEMCPY_NT_PREFETCH 16
+#endif
+
+/// Non-temporal copy of four vectors per iteration.
+static void copy_nt(uint8_t* restrict d, uint8_t const* restrict s, size_t n) {
+    svbool_t const all = svptrue_b8();
+    uint64_t const vl = svcntb();
+
+    size_t off = 0;
+    for (; off + 4 * vl <= n; off += 4 * vl) {
+        svprfb_vnum(all, s + off, MEMCPY_NT_PREFETCH, SV_PLDL2STRM);
+        svprfb_vnum(all, s + off, MEMCPY_NT_PREFETCH + 2, SV_PLDL2STRM);
+        svuint8_t const z0 = svldnt1_vnum_u8(all, s + off, 0);
+        svuint8_t const z1 = svldnt1_vnum_u8(all, s + off, 1);
+        svuint8_t const z2 = svldnt1_vnum_u8(all, s + off, 2);
+        svuint8_t const z3 = svldnt1_vnum_u8(all, s + off, 3);
+        svstnt1_vnum_u8(all, d + off, 0, z0);
+        svstnt1_vnum_u8(all, d + off, 1, z1);
+        svstnt1_vnum_u8(all, d + off, 2, z2);
+        svstnt1_vnum_u8(all, d + off, 3, z3);
+    }
+    for (; off < n; off += vl) {
+        svbool_t const pg = svwhilelt_b8_u64(off, n);
+        svstnt1_u8(pg, d + off, svldnt1_u8(pg, s + off));
+    }
+}
+
+/// `memcpy` mirroring `new_memcpy_aarch64_sve`.
+void* ACLE_FN(memcpy)(void* restrict dst, void const* restrict src, size_t n) {
+    uint8_t* d = (uint8_t*)dst;
+    uint8_t const* s = (uint8_t const*)src;
+    if (n >= MEMCPY_NT_THRESHOLD) {
+        copy_nt(d, s, n);
+        return dst;
+    }
+
+    svbool_t const all = svptrue_b8();
+    uint64_t const vl = svcntb();
+    svbool_t pg = svwhilelt_b8_u64(0, n);
+    for (size_t off = 0; svptest_any(all, pg); off += vl, pg = svwhilelt_b8_u64(off, n)) {
+        svst1_u8(pg, d + off, svld1_u8(pg, s + off));
+    }
+    return dst;
+}
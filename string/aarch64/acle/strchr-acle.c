@@ -0,0 +1,48 @@
+/**
+ * Copyright © 2004 - 2024, Université de Versailles Saint-Quentin-en-Yvelines (UVSQ)
+ * Copyright © 2024, Gabriel Dos Santos
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ **/
+
+#include "acle.h"
+
+/// `strchr` mirroring `new_strchr_aarch64_sve`.
+char* ACLE_FN(strchr)(char const* s, int32_t c) {
+    uint8_t const* p = (uint8_t const*)s;
+    svbool_t const all = svptrue_b8();
+    uint64_t const vl = svcntb();
+    svuint8_t const vc = svdup_n_u8((uint8_t)c);
+
+    // Read a vector's worth of bytes until `c` or a zero is found
+    svbool_t match, stop;
+    while (true) {
+        svuint8_t const v = svld1_u8(all, p);
+        match = svcmpeq_u8(all, v, vc);
+        stop = svorr_b_z(all, match, svcmpeq_n_u8(all, v, 0));
+        if (svptest_any(all, stop)) {
+            break;
+        }
+        p += vl;
+    }
+
+    // Point to the first such byte, if it is `c`
+    svbool_t const upto = svbrka_b_z(all, stop);
+    if (!svptest_any(upto, match)) {
+        return NULL;
+    }
+    return (char*)(p + svcntp_b8(all, upto) - 1);
+}
@@ -0,0 +1,45 @@
+/**
+ * Copyright © 2004 - 2024, Université de Versailles Saint-Quentin-en-Yvelines (UVSQ)
+ * Copyright © 2024, Gabriel Dos Santos
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ **/
+
+#include "acle.h"
+
+/// `strcmp` mirroring `new_strcmp_aarch64_sve`.
+int32_t ACLE_FN(strcmp)(char const* s1, char const* s2) {
+    uint8_t const* p1 = (uint8_t const*)s1;
+    uint8_t const* p2 = (uint8_t const*)s2;
+    svbool_t const all = svptrue_b8();
+    uint64_t const vl = svcntb();
+
+    // Read a vector's worth of bytes until an inequality or a zero is found
+    size_t off = 0;
+    svuint8_t a, b;
+    svbool_t stop;
+    do {
+        a = svld1_u8(all, p1 + off);
+        b = svld1_u8(all, p2 + off);
+        off += vl;
+        svbool_t const eq = svcmpeq_u8(all, a, b);
+        svbool_t const nonzero = svcmpne_n_u8(all, a, 0);
+        stop = svnand_b_z(all, eq, nonzero);
+    } while (!svptest_any(all, stop));
+
+    svbool_t const before = svbrkb_b_z(all, stop);
+    return (int32_t)svlasta_u8(before, a) - (int32_t)svlasta_u8(before, b);
+}
@@ -0,0 +1,47 @@
+/**
+ * Copyright © 2004 - 2024, Université de Versailles Saint-Quentin-en-Yvelines (UVSQ)
+ * Copyright © 2024, Gabriel Dos Santos
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ **/
+
+#include "acle.h"
+
+/// `strcpy` mirroring `new_strcpy_aarch64_sve`.
+char* ACLE_FN(strcpy)(char* restrict dst, char const* restrict src) {
+    uint8_t* d = (uint8_t*)dst;
+    uint8_t const* s = (uint8_t const*)src;
+    svbool_t const all = svptrue_b8();
+    uint64_t const vl = svcntb();
+
+    // Store whole vectors until a zero is found
+    size_t off = 0;
+    svuint8_t v;
+    svbool_t zero;
+    while (true) {
+        v = svld1_u8(all, s + off);
+        zero = svcmpeq_n_u8(all, v, 0);
+        if (svptest_any(all, zero)) {
+            break;
+        }
+        svst1_u8(all, d + off, v);
+        off += vl;
+    }
+
+    // Crop the last vector to the zero
+    svst1_u8(svbrka_b_z(all, zero), d + off, v);
+    return dst;
+}
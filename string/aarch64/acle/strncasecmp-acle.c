@@ -0,0 +1,51 @@
+/**
+ * Copyright © 2004 - 2024, Université de Versailles Saint-Quentin-en-Yvelines (UVSQ)
+ * Copyright © 2024, Gabriel Dos Santos
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ **/
+
+#include "acle.h"
+
+/// Folds the ASCII upper case letters of `v` to lower case.
+static inline svuint8_t fold(svbool_t pg, svuint8_t v) {
+    svbool_t const upper = svcmple_n_u8(svcmpge_n_u8(pg, v, 'A'), v, 'Z');
+    return svadd_n_u8_m(upper, v, 'a' - 'A');
+}
+
+/// `strncasecmp` mirroring `new_strncasecmp_aarch64_sve`.
+int32_t ACLE_FN(strncasecmp)(char const* s1, char const* s2, size_t n) {
+    uint8_t const* p1 = (uint8_t const*)s1;
+    uint8_t const* p2 = (uint8_t const*)s2;
+    svbool_t const all = svptrue_b8();
+    uint64_t const vl = svcntb();
+
+    for (size_t off = 0;; off += vl) {
+        svbool_t const pg = svwhilelt_b8_u64(off, n);
+        if (!svptest_any(all, pg)) {
+            return 0;
+        }
+        svuint8_t const a = fold(pg, svld1_u8(pg, p1 + off));
+        svuint8_t const b = fold(pg, svld1_u8(pg, p2 + off));
+        svbool_t const eq = svcmpeq_u8(pg, a, b);
+        svbool_t const nonzero = svcmpne_n_u8(pg, a, 0);
+        svbool_t const stop = svnand_b_z(pg, eq, nonzero);
+        if (svptest_any(pg, stop)) {
+            svbool_t const before = svbrkb_b_z(pg, stop);
+            return (int32_t)svlasta_u8(before, a) - (int32_t)svlasta_u8(before, b);
+        }
+    }
+}
@@ -0,0 +1,43 @@
+/**
+ * Copyright © 2004 - 2024, Université de Versailles Saint-Quentin-en-Yvelines (UVSQ)
+ * Copyright © 2024, Gabriel Dos Santos
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ **/
+
+#include "acle.h"
+
+/// `strncpy` mirroring `new_strncpy_aarch64_sve`.
+char* ACLE_FN(strncpy)(char* restrict dst, char const* restrict src, size_t n) {
+    uint8_t* d = (uint8_t*)dst;
+    uint8_t const* s = (uint8_t const*)src;
+    svbool_t const all = svptrue_b8();
+    uint64_t const vl = svcntb();
+
+    // Store whole vectors until a zero or the end of count is found
+    svbool_t pg = svwhilelt_b8_u64(0, n);
+    for (size_t off = 0; svptest_any(all, pg); off += vl, pg = svwhilelt_b8_u64(off, n)) {
+        svuint8_t const v = svld1_u8(pg, s + off);
+        svbool_t const zero = svcmpeq_n_u8(pg, v, 0);
+        if (svptest_any(pg, zero)) {
+            // Crop the vector to the zero
+            svst1_u8(svbrka_b_z(pg, zero), d + off, v);
+            break;
+        }
+        svst1_u8(pg, d + off, v);
+    }
+    return dst;
+}
@@ -0,0 +1,40 @@
+/**
+ * Copyright © 2004 - 2024, Université de Versailles Saint-Quentin-en-Yvelines (UVSQ)
+ * Copyright © 2024, Gabriel Dos Santos
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ **/
+
+#include "acle.h"
+
+/// `strnlen` mirroring `new_strnlen_aarch64_sve`.
+size_t ACLE_FN(strnlen)(char const* s, size_t n) {
+    uint8_t const* p = (uint8_t const*)s;
+    svbool_t const all = svptrue_b8();
+    uint64_t const vl = svcntb();
+
+    for (size_t off = 0;; off += vl) {
+        svbool_t const pg = svwhilelt_b8_u64(off, n);
+        if (!svptest_any(all, pg)) {
+            return n;
+        }
+        svuint8_t const v = svld1_u8(pg, p + off);
+        svbool_t const zero = svcmpeq_n_u8(pg, v, 0);
+        if (svptest_any(pg, zero)) {
+            return off + svcntp_b8(pg, svbrkb_b_z(pg, zero));
+        }
+    }
+}
@@ -0,0 +1,62 @@
+/**
+ * Copyright © 2004 - 2024, Université de Versailles Saint-Quentin-en-Yvelines (UVSQ)
+ * Copyright © 2024, Gabriel Dos Santos
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ **/
+
+#include "acle.h"
+
+/// `strrchr` mirroring `new_strrchr_aarch64_sve`.
+char* ACLE_FN(strrchr)(char const* s, int32_t c) {
+    uint8_t const* p = (uint8_t const*)s;
+    svbool_t const all = svptrue_b8();
+    uint64_t const vl = svcntb();
+    svuint8_t const vc = svdup_n_u8((uint8_t)c);
+
+    // Read a vector's worth of bytes until a zero is found, saving the last vector holding `c`
+    uint8_t const* last = NULL;
+    svbool_t last_match = svpfalse_b();
+    svuint8_t v;
+    svbool_t zero;
+    while (true) {
+        v = svld1_u8(all, p);
+        p += vl;
+        zero = svcmpeq_n_u8(all, v, 0);
+        if (svptest_any(all, zero)) {
+            break;
+        }
+        svbool_t const match = svcmpeq_u8(all, v, vc);
+        if (svptest_any(all, match)) {
+            last = p;
+            last_match = match;
+        }
+    }
+
+    // Search for `c` not after the end of the string, or fall back to the saved vector
+    svbool_t match = svcmpeq_u8(svbrka_b_z(all, zero), v, vc);
+    if (!svptest_any(all, match)) {
+        if (last == NULL) {
+            return NULL;
+        }
+        p = last;
+        match = last_match;
+    }
+
+    // Find the *last* match: the first one of the reversed predicate
+    svbool_t const from_last = svbrka_b_z(all, svrev_b8(match));
+    return (char*)(p - svcntp_b8(all, from_last));
+}
@@ -103,4 +103,31 @@ GNU_PROPERTY (FEATURE_1_AND, FEATURE_1_BTI|FEATURE_1_PAC)
 # endif
 #endif
 
+/* Fixed vector length builds (-msve-vector-bits=<bits>): the vector length is
+   known at assembly time.  VLS_NAME suffixes the symbol of a kernel with it,
+   SVE_PTRUE sets all the lanes of a vector with the matching VL pattern and
+   SVE_CNTB moves the vector length in bytes as an immediate.  */
+#if __ARM_FEATURE_SVE_BITS
+# define VLS_NAME(name) VLS_NAME_1 (name, __ARM_FEATURE_SVE_BITS)
+# define VLS_NAME_1(name, bits) VLS_NAME_2 (name, bits)
+# define VLS_NAME_2(name, bits) name ## _vl ## bits
+# if __ARM_FEATURE_SVE_BITS == 128
+#  define SVE_VL_PATTERN vl16
+# elif __ARM_FEATURE_SVE_BITS == 256
+#  define SVE_VL_PATTERN vl32
+# elif __ARM_FEATURE_SVE_BITS == 512
+#  define SVE_VL_PATTERN vl64
+# elif __ARM_FEATURE_SVE_BITS == 1024
+#  define SVE_VL_PATTERN vl128
+# else
+#  define SVE_VL_PATTERN vl256
+# endif
+# define SVE_PTRUE(p) ptrue p.b, SVE_VL_PATTERN
+# define SVE_CNTB(x) mov x, (__ARM_FEATURE_SVE_BITS / 8)
+#else
+# define VLS_NAME(name) name
+# define SVE_PTRUE(p) ptrue p.b, all
+# define SVE_CNTB(x) cntb x
+#endif
+
 #endif
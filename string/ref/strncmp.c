@@ -0,0 +1,33 @@
+/**
+ * Copyright © 2004 - 2024, Université de Versailles Saint-Quentin-en-Yvelines (UVSQ)
+ * Copyright © 2024, Gabriel Dos Santos
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ **/
+
+#include "driver.h"
+
+/// Byte-by-byte `strncmp`.
+int32_t ref_strncmp(char const* s1, char const* s2, size_t n) {
+    unsigned char const* a = (unsigned char const*)s1;
+    unsigned char const* b = (unsigned char const*)s2;
+    for (size_t i = 0; i < n; ++i) {
+        if (a[i] != b[i] || a[i] == 0) {
+            return a[i] - b[i];
+        }
+    }
+    return 0;
+}
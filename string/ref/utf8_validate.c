@@ -0,0 +1,59 @@
+/**
+ * Copyright © 2004 - 2024, Université de Versailles Saint-Quentin-en-Yvelines (UVSQ)
+ * Copyright © 2024, Gabriel Dos Santos
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ **/
+
+#include "driver.h"
+
+/// Sequence-by-sequence UTF-8 validation (rejects overlong encodings, surrogates and code points
+/// above U+10FFFF). Returns 1 if the `n` bytes of `s` are valid UTF-8, 0 otherwise.
+int32_t ref_utf8_validate(char const* s, size_t n) {
+    unsigned char const* p = (unsigned char const*)s;
+    size_t i = 0;
+    while (i < n) {
+        uint32_t cp = p[i];
+        size_t len;
+        uint32_t min;
+        if (cp < 0x80) {
+            i += 1;
+            continue;
+        } else if ((cp & 0xe0) == 0xc0) {
+            len = 2, min = 0x80, cp &= 0x1f;
+        } else if ((cp & 0xf0) == 0xe0) {
+            len = 3, min = 0x800, cp &= 0x0f;
+        } else if ((cp & 0xf8) == 0xf0) {
+            len = 4, min = 0x10000, cp &= 0x07;
+        } else {
+            return 0;
+        }
+        if (n - i < len) {
+            return 0;
+        }
+        for (size_t k = 1; k < len; ++k) {
+            if ((p[i + k] & 0xc0) != 0x80) {
+                return 0;
+            }
+            cp = (cp << 6) | (p[i + k] & 0x3f);
+        }
+        if (cp < min || cp > 0x10ffff || (cp >= 0xd800 && cp <= 0xdfff)) {
+            return 0;
+        }
+        i += len;
+    }
+    return 1;
+}